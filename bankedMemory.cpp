@@ -0,0 +1,111 @@
+///////////////////////////////////
+// Banked Memory
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This file models the banks of main memory.  Accesses are
+handed ports in the order they are made, and the simulator runs
+the memory streamers in the order they were added, so the same
+streamer wins a conflict every time.
+*/
+
+#ifndef BANKEDMEMORY_CPP
+#define BANKEDMEMORY_CPP
+
+#include"bankedMemory.h"
+
+// Banks the memory streamers that use memory
+BankedMemory::BankedMemory(int * memory, int numBanks, int interleave, int ports){
+    this->memory = memory;
+    this->numBanks = numBanks < 1 ? 1 : numBanks;
+    this->interleave = interleave < 1 ? 1 : interleave;
+    this->ports = ports < 1 ? 1 : ports;
+    this->cycles = 0;
+    this->used.assign(this->numBanks, 0);
+    this->accesses.assign(this->numBanks, 0);
+    this->conflicts.assign(this->numBanks, 0);
+    this->busyCycles.assign(this->numBanks, 0);
+    this->portsUsed.assign(this->numBanks, 0);
+};
+
+// Frees every port for a new cycle
+void BankedMemory::beginCycle(){
+    for(int b=0; b < this->numBanks; b++){
+        this->used[b] = 0;
+    }
+    this->cycles++;
+};
+
+// Claims a port of addr's bank - returns the rounds the access waits for one
+// With 2 ports, the first two accesses to a bank wait 0 rounds, the next two wait 1, and so on
+int BankedMemory::access(int addr){
+    int bank = this->getBank(addr);
+    int wait = this->used[bank] / this->ports;
+    if(this->used[bank] == 0){
+        this->busyCycles[bank]++;
+    }
+    if(this->used[bank] < this->ports){
+        this->portsUsed[bank]++;
+    }
+    this->used[bank]++;
+    this->accesses[bank]++;
+    this->conflicts[bank] += wait;
+    return wait;
+};
+
+// Which bank an address lands in
+int BankedMemory::getBank(int addr){
+    int bank = (addr / this->interleave) % this->numBanks;
+    return bank < 0 ? bank + this->numBanks : bank;
+};
+
+int BankedMemory::getNumBanks(){
+    return this->numBanks;
+};
+
+int BankedMemory::getInterleave(){
+    return this->interleave;
+};
+
+int BankedMemory::getPorts(){
+    return this->ports;
+};
+
+// Cycles the banks have been run
+int BankedMemory::getCycles(){
+    return this->cycles;
+};
+
+// Accesses a bank served
+long long BankedMemory::getAccesses(int bank){
+    return this->accesses[bank];
+};
+
+// Rounds accesses waited for a bank's ports
+long long BankedMemory::getConflicts(int bank){
+    return this->conflicts[bank];
+};
+
+// Cycles a bank served at least one access
+int BankedMemory::getBusyCycles(int bank){
+    return this->busyCycles[bank];
+};
+
+// Fraction of a bank's port cycles that served an access - accesses that waited for a port don't add to it
+double BankedMemory::getUtilization(int bank){
+    if(this->cycles == 0){
+        return 0.0;
+    }
+    return (double)this->portsUsed[bank] / ((double)this->cycles * this->ports);
+};
+
+// Prints the counters of every bank
+void BankedMemory::report(){
+    for(int b=0; b < this->numBanks; b++){
+        printf("Bank %i: %lli accesses, %lli conflict stalls, busy %i of %i cycles, %.1f%% utilized\n", b, this->accesses[b],
+	       this->conflicts[b], this->busyCycles[b], this->cycles, 100.0 * this->getUtilization(b));
+    }
+};
+
+#endif
@@ -0,0 +1,55 @@
+///////////////////////////////////
+// Banked Memory Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for the banked memory timing model.
+Main memory is split into banks, and consecutive blocks of
+interleave words go to consecutive banks, so with 4 banks and an
+interleave of 1, addresses 0 1 2 3 land in banks 0 1 2 3 and
+address 4 is back in bank 0.  Each bank has ports that can each
+serve one access a cycle.  When more memory streamers hit a bank
+on the same cycle than it has ports, the extra accesses wait a
+round each, and the simulator charges those rounds into the cycle.
+The data itself stays in the one array the streamers already
+share - this only decides what the accesses cost.
+*/
+
+#ifndef BANKEDMEMORY_H
+#define BANKEDMEMORY_H
+
+#include<vector>
+#include<stdio.h>
+using namespace std;
+
+class BankedMemory{
+    public:
+	BankedMemory(int * memory, int numBanks, int interleave, int ports); // Banks the memory streamers that use memory
+	int * memory;                           // Main memory that is banked
+	void beginCycle();                      // Frees every port for a new cycle
+	int access(int addr);                   // Claims a port of addr's bank - returns the rounds the access waits for one
+	int getBank(int addr);                  // Which bank an address lands in
+	int getNumBanks();
+	int getInterleave();
+	int getPorts();
+	int getCycles();                        // Cycles the banks have been run
+	long long getAccesses(int bank);        // Accesses a bank served
+	long long getConflicts(int bank);       // Rounds accesses waited for a bank's ports
+	int getBusyCycles(int bank);            // Cycles a bank served at least one access
+	double getUtilization(int bank);        // Fraction of a bank's port cycles that served an access
+	void report();                          // Prints the counters of every bank
+
+    private:
+	int numBanks;
+	int interleave;                         // Words in a row that go to the same bank
+	int ports;                              // Accesses a bank serves each cycle
+	int cycles;
+	std::vector<int> used;                  // Accesses each bank has taken this cycle
+	std::vector<long long> accesses;
+	std::vector<long long> conflicts;
+	std::vector<int> busyCycles;
+	std::vector<long long> portsUsed;       // Port cycles that served an access
+};
+
+#endif
@@ -21,6 +21,7 @@ Here is a list with basic descriptions:
 #define BASECLASS_H
 
 #include<iostream>
+#include<assert.h>
 using namespace std;
 
 
@@ -51,9 +52,14 @@ enum Instruction{
     PASS_THROUGH_2 = 17,
     DEQ = 18, 
     SHIFT_RIGHT = 19,
-    SHIFT_LEFT = 20
+    SHIFT_LEFT = 20,
+    PUSH_POP = 21,    // Burst mode fifo pushing and popping on the same cycle
+    MULTIPLY_ACCUMULATE = 22
 };
 
+// Number of instructions in the enum - used to size instruction indexed tables, so keep it one past the last instruction
+#define NUM_INSTRUCTIONS 23
+
 // Different ways that you can interpret ALU results to update the predicate
 enum predUpdateType{
     ANY = 0,
@@ -64,38 +70,57 @@ enum predUpdateType{
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Most values an in-flight instruction can hold - PASS_THROUGH_2 holds two data values and two tags
+// In-flight results are kept in fixed arrays of this size so that no instruction allocates memory
+#define MAX_RESULTS 4
+
+// Most predicate updates one instruction can make - TIA::legal rejects instructions with more
+#define MAX_PRED_UPDATES 8
+
+
 // Beginning of Dynamic_Instruction class
 
 
 class Dynamic_Instruction{
     public:
         Dynamic_Instruction(Instruction instruction);       // Construction that takes ALU instruction
-	std::vector<int> getUncommittedResult();               // Get current in-flight result
-	void setUncommittedResult(std::vector<int> result);    // Set current in-flight result
+	const int * getUncommittedResult();                    // Get current in-flight result - getNumResults() values long
+	int getNumResults();                                   // Get number of values in the in-flight result
+	void addResult(int value);                             // Add a value to the end of the in-flight result
 	Instruction getInst();                                 // Get ALU instruction
 	void setInst(Instruction i);                           // Set ALU instruction
 
     private:
-	std::vector<int> uncommittedResult;
+	int uncommittedResult[MAX_RESULTS];
+	int numResults;
 	Instruction inst;
 };
 
 
 // Constructor that takes the ALU instruction
 Dynamic_Instruction::Dynamic_Instruction(Instruction instruction){ 
-    std::vector<int> uR;
-    this->uncommittedResult = uR; // Set some initial uncommitted result value
+    for(int i=0; i<MAX_RESULTS; i++){
+        this->uncommittedResult[i] = 0; // Set some initial uncommitted result value
+    }
+    this->numResults = 0;
     this->inst = instruction;     // Set actual ALU instruction 
 }
 
 // Get current in-flight result
-std::vector<int> Dynamic_Instruction::getUncommittedResult(){
+const int * Dynamic_Instruction::getUncommittedResult(){
     return this->uncommittedResult;
 }
 
-// Set current in-flight result
-void Dynamic_Instruction::setUncommittedResult(std::vector<int> result){
-    this->uncommittedResult = result;
+// Get number of values in the in-flight result
+int Dynamic_Instruction::getNumResults(){
+    return this->numResults;
+}
+
+// Add a value to the end of the in-flight result - a module that adds more than MAX_RESULTS has a bug
+void Dynamic_Instruction::addResult(int value){
+    assert(this->numResults < MAX_RESULTS);
+    this->uncommittedResult[this->numResults] = value;
+    this->numResults++;
 }
 
 // Get ALU instruction
@@ -279,26 +304,27 @@ std::vector<int> DataRegs::getState(){
 
 class TIAinstruction {
     public:
-        TIAinstruction(Instruction command, std::vector<pair<int, bool> > pState, std::vector<pair<int, bool> > iFlags, std::vector<pair<int, int> > iChans, std::vector<pair<bool, int> >oChans, int tagUp, std::vector<int> deQ, std::vector<pair<int, int> > drUpdates);                                         // Constructor
+        TIAinstruction(Instruction command, const std::vector<pair<int, bool> > &pState, const std::vector<pair<int, bool> > &iFlags, const std::vector<pair<int, int> > &iChans, const std::vector<pair<bool, int> > &oChans, int tagUp, const std::vector<int> &deQ, const std::vector<pair<int, int> > &drUpdates); // Constructor
         void setCmd(Instruction newCmd);                             // Allows you to set/change the ALU instruction that is computed in Execute
-        void setPredState(std::vector<pair<int, bool> > pState);     // Sets the required predicate state for this instruction to be triggered
-        void setInputFlags(std::vector<pair<int, bool> > iFlags);    // Sets the required flags of the input channels for this intruction to be triggered
-        void setInput(std::vector<pair<int, int> > iChans);         // Sets which inputs the instruction uses
-        void setOutput(std::vector<pair<bool, int> > oChans);        // Sets where the output from this instruction goes
+        void setPredState(const std::vector<pair<int, bool> > &pState);     // Sets the required predicate state for this instruction to be triggered
+        void setInputFlags(const std::vector<pair<int, bool> > &iFlags);    // Sets the required flags of the input channels for this intruction to be triggered
+        void setInput(const std::vector<pair<int, int> > &iChans);          // Sets which inputs the instruction uses
+        void setOutput(const std::vector<pair<bool, int> > &oChans);        // Sets where the output from this instruction goes
         void setTagUpdate(int tag);                                  // Set the tag on outgoing messages 
         void setDequeue(int index);                                  // Add an input channel to dequeue upon finishing the instruction
-        void setPredUpdates(std::vector<pair<predUpdateType, pair<int, bool> > > pUpdates); // Set updates to the Predicate Registers
-        void setDataRegUpdates(std::vector<pair<int, int> > drUpdates); // Set updates to the Data Registers
-
-        int getCmd();                                   // Get the ALU instruction that is computed in Execute 
-        std::vector<pair<int, bool> > getPredState();   // Gets the required predicate state for this instruction to be triggered
-        std::vector<pair<int, bool> > getInputFlags();  // Gets the required flags of the input channels for this instruction to be triggered
-        std::vector<pair<int, int> > getInput();       // Gets which inputs the instruction uses
-        std::vector<pair<bool, int> > getOutput();      // Gets where the output from this instruction goes 
-	int getTagUpdate();                             // Get the tag for outgoing messages
-	std::vector<int> getDequeue();                  // Get which channels should be dequeued upon intrunction commit
-	std::vector<pair<predUpdateType, pair<int, bool> > > getPredUpdates(); // Get updates to the Predicated Registers
-        std::vector<pair<int, int> > getDataRegUpdates(); // Get updates to the Data Registers
+        void setPredUpdates(const std::vector<pair<predUpdateType, pair<int, bool> > > &pUpdates); // Set updates to the Predicate Registers
+        void setDataRegUpdates(const std::vector<pair<int, int> > &drUpdates); // Set updates to the Data Registers
+
+        // Getters return references to the internal lists so that reading an instruction never copies it
+        int getCmd() const;                                          // Get the ALU instruction that is computed in Execute 
+        const std::vector<pair<int, bool> > &getPredState() const;   // Gets the required predicate state for this instruction to be triggered
+        const std::vector<pair<int, bool> > &getInputFlags() const;  // Gets the required flags of the input channels for this instruction to be triggered
+        const std::vector<pair<int, int> > &getInput() const;        // Gets which inputs the instruction uses
+        const std::vector<pair<bool, int> > &getOutput() const;      // Gets where the output from this instruction goes 
+	int getTagUpdate() const;                                    // Get the tag for outgoing messages
+	const std::vector<int> &getDequeue() const;                  // Get which channels should be dequeued upon intrunction commit
+	const std::vector<pair<predUpdateType, pair<int, bool> > > &getPredUpdates() const; // Get updates to the Predicated Registers
+        const std::vector<pair<int, int> > &getDataRegUpdates() const; // Get updates to the Data Registers
 
     private:
         Instruction cmd;                           // Internal ALU command
@@ -314,7 +340,7 @@ class TIAinstruction {
 
 
 // Constructor
-TIAinstruction::TIAinstruction(Instruction command, std::vector<pair<int, bool> > pState, std::vector<pair<int, bool> > iFlags, std::vector<pair<int, int> > iChans, std::vector<pair<bool,int> >oChans, int tagUp, std::vector<int> deQ, std::vector<pair<int, int> >drUpdates){
+TIAinstruction::TIAinstruction(Instruction command, const std::vector<pair<int, bool> > &pState, const std::vector<pair<int, bool> > &iFlags, const std::vector<pair<int, int> > &iChans, const std::vector<pair<bool,int> > &oChans, int tagUp, const std::vector<int> &deQ, const std::vector<pair<int, int> > &drUpdates){
     this->cmd = command;        // Sets initial ALU command
     this->predState = pState;   // Sets initial predicate state required to trigger inst
     this->inputFlags = iFlags;  // Sets initial input flags required to trigger inst
@@ -331,22 +357,22 @@ void TIAinstruction::setCmd(Instruction newCmd){
 }
 
 // Sets the required predicate state for this instruction to be triggered
-void TIAinstruction::setPredState(std::vector<pair<int, bool> > pState){
+void TIAinstruction::setPredState(const std::vector<pair<int, bool> > &pState){
     this->predState = pState;
 }
 
 // Sets the required flags of the input channels for this intruction to be triggered
-void TIAinstruction::setInputFlags(std::vector<pair<int, bool> > iFlags){
+void TIAinstruction::setInputFlags(const std::vector<pair<int, bool> > &iFlags){
     this->inputFlags = iFlags;
 }
 
 // Sets which inputs the instruction uses
-void TIAinstruction::setInput(std::vector<pair<int, int> > iChans){
+void TIAinstruction::setInput(const std::vector<pair<int, int> > &iChans){
     this->input = iChans;
 }
 
 // Sets where the output from this instruction goes
-void TIAinstruction::setOutput(std::vector<pair<bool, int> >oChans){
+void TIAinstruction::setOutput(const std::vector<pair<bool, int> > &oChans){
     this->output = oChans;
 }
 
@@ -361,58 +387,58 @@ void TIAinstruction::setDequeue(int index){
 }
 
 // Set updates to the Predicate Registers
-void TIAinstruction::setPredUpdates(std::vector<pair<predUpdateType, pair<int, bool> > > pUpdates){
+void TIAinstruction::setPredUpdates(const std::vector<pair<predUpdateType, pair<int, bool> > > &pUpdates){
     this->predUpdates = pUpdates;
 }
 
 // Set updates to the Data Registers
-void TIAinstruction::setDataRegUpdates(std::vector<pair<int, int> > drUpdates){
+void TIAinstruction::setDataRegUpdates(const std::vector<pair<int, int> > &drUpdates){
     this->dataRegUpdates = drUpdates;
 }
 
 
 // Get the ALU instruction that is computed in Execute
-int TIAinstruction::getCmd(){
+int TIAinstruction::getCmd() const{
     return this->cmd;
 }
 
 // Gets the required predicate state for this instruction to be triggered
-std::vector<pair<int, bool> > TIAinstruction::getPredState(){
+const std::vector<pair<int, bool> > &TIAinstruction::getPredState() const{
     return this->predState;
 }
 
 // Gets the required flags of the input channels for this instruction to be triggered
-std::vector<pair<int, bool> > TIAinstruction::getInputFlags(){
+const std::vector<pair<int, bool> > &TIAinstruction::getInputFlags() const{
     return this->inputFlags;
 }
 
 // Gets which inputs the instruction uses
-std::vector<pair<int, int> > TIAinstruction::getInput(){
+const std::vector<pair<int, int> > &TIAinstruction::getInput() const{
     return this->input;
 }
 
 // Gets where the output from this instruction goes
-std::vector<pair<bool, int> >TIAinstruction::getOutput(){
+const std::vector<pair<bool, int> > &TIAinstruction::getOutput() const{
     return this->output;
 }
 
 // Get the tag for outgoing messages
-int TIAinstruction::getTagUpdate(){
+int TIAinstruction::getTagUpdate() const{
     return this->tagUpdate;
 }
 
 // Get which channels should be dequeued upon intrunction commit
-std::vector<int> TIAinstruction::getDequeue(){
+const std::vector<int> &TIAinstruction::getDequeue() const{
     return this->dequeue;
 }
 
 // Get updates to the Predicated Registers
-std::vector<pair<predUpdateType, pair<int, bool> > > TIAinstruction::getPredUpdates(){
+const std::vector<pair<predUpdateType, pair<int, bool> > > &TIAinstruction::getPredUpdates() const{
     return this->predUpdates;
 }
 
 // Get updates to the Predicated Registers
-std::vector<pair<int, int> > TIAinstruction::getDataRegUpdates(){
+const std::vector<pair<int, int> > &TIAinstruction::getDataRegUpdates() const{
     return this->dataRegUpdates;
 }
 
@@ -428,50 +454,71 @@ std::vector<pair<int, int> > TIAinstruction::getDataRegUpdates(){
 class Dynamic_TIAinstruction{
     public:
         Dynamic_TIAinstruction(int index, Instruction command); // Construction that takes static TIAinstruction
-	std::vector<int> getUncommittedResult();               // Get current in-flight result
-	void setUncommittedResult(std::vector<int> result);    // Set current in-flight result
-	std::vector<pair<int, bool> > getPredUpdates();        // Get predUpdates for this inst
-	void setPredUpdates(std::vector<pair<int, bool> > pU); // Set predUpdates for this inst
+	const int * getUncommittedResult();                    // Get current in-flight result - getNumResults() values long
+	int getNumResults();                                   // Get number of values in the in-flight result
+	void addResult(int value);                             // Add a value to the end of the in-flight result
+	const pair<int, bool> * getPredUpdates();             // Get predUpdates for this inst - getNumPredUpdates() long
+	int getNumPredUpdates();                               // Get number of predUpdates for this inst
+	void addPredUpdate(int reg, bool value);               // Add a predicate update to this inst
 	int getIndex();
 	void setIndex(int in);
 	Instruction getCmd();
 	void setCmd(Instruction command);
 
     private:
-	std::vector<int> uncommittedResult;
+	int uncommittedResult[MAX_RESULTS];
+	int numResults;
 	int iMemIndex;
-        std::vector<pair<int, bool> > predUpdates;
+	pair<int, bool> predUpdates[MAX_PRED_UPDATES];
+	int numPredUpdates;
 	Instruction cmd;
 };
 
 
 // Constructor inherits from TIAinstruction and uses its constructor
 Dynamic_TIAinstruction::Dynamic_TIAinstruction(int index, Instruction command){ 
-    std::vector<int> uR;
-    this->uncommittedResult = uR;  // Set some initial uncommitted result value
+    for(int i=0; i<MAX_RESULTS; i++){
+        this->uncommittedResult[i] = 0; // Set some initial uncommitted result value
+    }
+    this->numResults = 0;
+    this->numPredUpdates = 0;
     this->iMemIndex = index;       // Set correct pointer into iMem
     this->cmd = command;
 }
 
-// Set predicate updates for this inst
-void Dynamic_TIAinstruction::setPredUpdates(std::vector<pair<int, bool> > pU){
-    this->predUpdates = pU;
+// Add a predicate update to this inst - TIA::legal keeps instructions from adding more than MAX_PRED_UPDATES
+void Dynamic_TIAinstruction::addPredUpdate(int reg, bool value){
+    assert(this->numPredUpdates < MAX_PRED_UPDATES);
+    this->predUpdates[this->numPredUpdates] = make_pair(reg, value);
+    this->numPredUpdates++;
 }
 
 // Get updates to the Predicated Registers
-std::vector<pair<int, bool> > Dynamic_TIAinstruction::getPredUpdates(){
+const pair<int, bool> * Dynamic_TIAinstruction::getPredUpdates(){
     return this->predUpdates;
 }
 
+// Get number of updates to the Predicated Registers
+int Dynamic_TIAinstruction::getNumPredUpdates(){
+    return this->numPredUpdates;
+}
+
 
 // Get current in-flight result
-std::vector<int> Dynamic_TIAinstruction::getUncommittedResult(){
+const int * Dynamic_TIAinstruction::getUncommittedResult(){
     return this->uncommittedResult;
 }
 
-// Set current in-flight result
-void Dynamic_TIAinstruction::setUncommittedResult(std::vector<int> result){
-    this->uncommittedResult = result;
+// Get number of values in the in-flight result
+int Dynamic_TIAinstruction::getNumResults(){
+    return this->numResults;
+}
+
+// Add a value to the end of the in-flight result - TIA::legal keeps instructions from adding more than MAX_RESULTS
+void Dynamic_TIAinstruction::addResult(int value){
+    assert(this->numResults < MAX_RESULTS);
+    this->uncommittedResult[this->numResults] = value;
+    this->numResults++;
 }
 
 // Get index of iMem inst
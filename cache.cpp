@@ -0,0 +1,159 @@
+///////////////////////////////////
+// Cache
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This file models a set-associative cache.  Lines are
+lineSize words, and consecutive lines go to consecutive sets.
+*/
+
+#ifndef CACHE_CPP
+#define CACHE_CPP
+
+#include"cache.h"
+
+// Size and line size are in words
+Cache::Cache(int size, int ways, int lineSize, ReplacementPolicy policy, bool writeBack, int hitLatency, int missLatency){
+    this->lineSize = lineSize < 1 ? 1 : lineSize;
+    this->ways = ways < 1 ? 1 : ways;
+    this->numSets = size / (this->lineSize * this->ways);
+    if(this->numSets < 1){
+        fprintf(stderr, "Cache of %i words can't hold %i ways of %i words - using one set\n", size, this->ways, this->lineSize);
+	this->numSets = 1;
+    }
+    this->policy = policy;
+    this->writeBack = writeBack;
+    this->hitLatency = hitLatency;
+    this->missLatency = missLatency;
+    this->tags.assign(this->numSets * this->ways, 0);
+    this->valid.assign(this->numSets * this->ways, 0);
+    this->dirty.assign(this->numSets * this->ways, 0);
+    this->stamps.assign(this->numSets * this->ways, 0);
+    this->clock = 0;
+    this->seed = 12345;
+    this->hits = 0;
+    this->misses = 0;
+    this->evictions = 0;
+    this->writeBacks = 0;
+};
+
+// Looks up an address, filling its line on a miss
+CacheAccess Cache::access(int addr, bool write){
+    CacheAccess result = {false, false, false, false, this->hitLatency};
+    int line = addr / this->lineSize;
+    int set = line % this->numSets;
+    if(set < 0){
+        set += this->numSets;
+    }
+    int first = set * this->ways;
+    this->clock++;
+
+    for(int w=first; w < first + this->ways; w++){
+        if(this->valid[w] && this->tags[w] == line){
+	    result.hit = true;
+	    this->hits++;
+	    if(this->policy == LRU_REPLACE){
+	        this->stamps[w] = this->clock;
+	    }
+	    if(write && this->writeBack){
+	        this->dirty[w] = 1;
+	    }
+	    if(write && !this->writeBack){
+	        result.latency = this->missLatency;  // The line is updated, but the write still goes out to memory
+		result.toMemory = true;
+	    }
+	    return result;
+	}
+    }
+
+    this->misses++;
+    result.latency = this->missLatency;
+    result.toMemory = true;
+    if(write && !this->writeBack){
+        return result;  // Write-through doesn't fill a line on a write miss
+    }
+    int w = first + this->victim(set);
+    if(this->valid[w]){
+        result.evicted = true;
+	this->evictions++;
+	if(this->dirty[w]){
+	    result.wroteBack = true;
+	    result.latency += this->missLatency;
+	    this->writeBacks++;
+	}
+    }
+    this->tags[w] = line;
+    this->valid[w] = 1;
+    this->dirty[w] = write ? 1 : 0;
+    this->stamps[w] = this->clock;
+    return result;
+};
+
+// Way to fill in a set - an empty way if there is one
+int Cache::victim(int set){
+    int first = set * this->ways;
+    for(int w=0; w < this->ways; w++){
+        if(!this->valid[first + w]){
+	    return w;
+	}
+    }
+    if(this->policy == RANDOM_REPLACE){
+        this->seed = this->seed * 1103515245 + 12345;
+	return (this->seed >> 16) % this->ways;
+    }
+    // LRU and FIFO both evict the oldest stamp - they differ in whether a hit refreshes it
+    int oldest = 0;
+    for(int w=1; w < this->ways; w++){
+        if(this->stamps[first + w] < this->stamps[first + oldest]){
+	    oldest = w;
+	}
+    }
+    return oldest;
+};
+
+// Writes back every dirty line and empties the cache
+void Cache::flush(){
+    for(unsigned w=0; w < this->valid.size(); w++){
+        if(this->valid[w] && this->dirty[w]){
+	    this->writeBacks++;
+	}
+	this->valid[w] = 0;
+	this->dirty[w] = 0;
+    }
+};
+
+int Cache::getNumSets(){
+    return this->numSets;
+};
+
+int Cache::getWays(){
+    return this->ways;
+};
+
+int Cache::getLineSize(){
+    return this->lineSize;
+};
+
+bool Cache::getWriteBack(){
+    return this->writeBack;
+};
+
+// Totals over every streamer that uses the cache
+long long Cache::getHits(){
+    return this->hits;
+};
+
+long long Cache::getMisses(){
+    return this->misses;
+};
+
+long long Cache::getEvictions(){
+    return this->evictions;
+};
+
+long long Cache::getWriteBacks(){
+    return this->writeBacks;
+};
+
+#endif
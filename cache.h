@@ -0,0 +1,74 @@
+///////////////////////////////////
+// Cache Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for the set-associative cache timing model.
+A cache sits between the memory streamers and main memory and decides
+whether each read or write hits, taking hitLatency cycles, or misses
+and goes out to memory, taking missLatency cycles.  The cache only
+keeps tags - the data always lives in main memory - so it changes what
+accesses cost but never what they return.
+A write-back cache fills a line on a write miss and marks it dirty, and
+a dirty line that is evicted costs another missLatency to write out.
+A write-through cache sends every write to memory at missLatency, and
+a write miss doesn't fill a line.
+*/
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include<vector>
+#include<stdio.h>
+using namespace std;
+
+// Ways that a full set picks the line to evict
+enum ReplacementPolicy{
+    LRU_REPLACE = 0,    // Line that was used longest ago
+    FIFO_REPLACE = 1,   // Line that was filled longest ago
+    RANDOM_REPLACE = 2  // Any line - from a fixed seed so every run evicts the same lines
+};
+
+// What one access did
+struct CacheAccess{
+    bool hit;
+    bool evicted;        // A valid line was replaced to make room
+    bool wroteBack;      // The replaced line was dirty and had to be written out
+    bool toMemory;       // The access went out to main memory
+    int latency;         // Cycles the access took
+};
+
+class Cache{
+    public:
+	Cache(int size, int ways, int lineSize, ReplacementPolicy policy, bool writeBack, int hitLatency, int missLatency); // Size and line size are in words
+	CacheAccess access(int addr, bool write); // Looks up an address, filling its line on a miss
+	void flush();                           // Writes back every dirty line and empties the cache
+	int getNumSets();
+	int getWays();
+	int getLineSize();
+	bool getWriteBack();
+	long long getHits();                    // Totals over every streamer that uses the cache
+	long long getMisses();
+	long long getEvictions();
+	long long getWriteBacks();
+	int hitLatency;                         // Cycles of a hit
+	int missLatency;                        // Cycles of a miss, or of a write out to memory
+
+    private:
+	int numSets;
+	int ways;
+	int lineSize;
+	ReplacementPolicy policy;
+	bool writeBack;
+	std::vector<int> tags;                  // Line address held by each way of each set, set by set
+	std::vector<char> valid;
+	std::vector<char> dirty;
+	std::vector<long long> stamps;          // When each way was last used, or filled for FIFO_REPLACE
+	long long clock;                        // Counts accesses for the stamps
+	unsigned int seed;                      // State of the random replacement
+	long long hits, misses, evictions, writeBacks;
+	int victim(int set);                    // Way to fill in a set
+};
+
+#endif
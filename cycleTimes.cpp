@@ -0,0 +1,178 @@
+///////////////////////////////////
+// Cycle Times
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This file loads the keyed cycle time file into the dense
+table that the simulator looks up every cycle.
+*/
+
+#ifndef CYCLETIMES_CPP
+#define CYCLETIMES_CPP
+
+#include"cycleTimes.h"
+
+// Names used in the cycle time file - these line up with the enums
+static const char * moduleNames[NUM_MODULE_TYPES] = {"MemStream", "Fifo", "Multiplier", "TIA", "MAC"};
+static const char * phaseNames[NUM_PHASES] = {"Schedule", "Execute", "Commit", "Load", "Swap"};
+static const char * instructionNames[NUM_INSTRUCTIONS] = {
+    "NOP", "PUSH", "POP", "START_STREAM", "STOP_STREAM", "STREAM", "WRITE_MEM", "MULTIPLY",
+    "PLUSPLUS", "MINUSMINUS", "ADD", "SUBTRACT", "LESS_THAN", "GREATER_THAN", "LESS_THAN_EQUAL",
+    "GREATER_THAN_EQUAL", "PASS_THROUGH", "PASS_THROUGH_2", "DEQ", "SHIFT_RIGHT", "SHIFT_LEFT",
+    "PUSH_POP", "MULTIPLY_ACCUMULATE"
+};
+
+// Strips spaces and tabs off of both ends of a cell
+static std::string trimCell(const std::string &cell){
+    int begin = 0, end = cell.size();
+    while(begin < end && (cell[begin] == ' ' || cell[begin] == '\t')){
+        begin++;
+    }
+    while(end > begin && (cell[end-1] == ' ' || cell[end-1] == '\t')){
+        end--;
+    }
+    return cell.substr(begin, end - begin);
+}
+
+// Constructor - every time starts at 0
+CycleTimes::CycleTimes(){
+    for(int m=0; m < NUM_MODULE_TYPES; m++){
+        for(int i=0; i < NUM_INSTRUCTIONS; i++){
+	    for(int p=0; p < NUM_PHASES; p++){
+	        this->times[m][p][i] = 0;
+	    }
+	    this->totals[m][i] = 0;
+	}
+    }
+    this->lineNum = 0;
+};
+
+// Reads a keyed cycle time file - returns false if it can't be opened or has a bad line
+bool CycleTimes::load(const char * fileName){
+    std::ifstream data(fileName);
+    if(!data.is_open()){
+        fprintf(stderr, "Could not open cycle time file %s\n", fileName);
+        return false;
+    }
+
+    std::string line;
+    this->lineNum = 0;
+    bool ok = true;
+    while(readLine(data, line)){
+        this->lineNum++;
+	ok = this->parseLine(line) && ok;  // Keep going so every bad line gets reported
+    }
+    return ok;
+};
+
+// Parses one "module, phase, instruction, cycles" line
+bool CycleTimes::parseLine(const std::string &line){
+    std::string cells[4];
+    int numCells = 0;
+    std::stringstream lineStream(line);
+    std::string cell;
+    while(std::getline(lineStream, cell, ',')){
+        if(numCells < 4){
+	    cells[numCells] = trimCell(cell);
+	}
+	numCells++;  // Count every cell, so a line with extra ones is rejected below
+    }
+
+    // Skip blank lines and comments
+    if(numCells == 0 || cells[0].size() == 0 || cells[0][0] == '#'){
+        return true;
+    }
+    if(numCells != 4){
+        fprintf(stderr, "Cycle time line %i should be module, phase, instruction, cycles\n", this->lineNum);
+        return false;
+    }
+
+    int cycles;
+    if(!parseInt(cells[3], cycles) || cycles < 0){
+        fprintf(stderr, "Cycle time line %i has a bad number of cycles %s\n", this->lineNum, cells[3].c_str());
+        return false;
+    }
+    if(!this->set(cells[0], cells[1], cells[2], cycles)){
+        fprintf(stderr, "Unknown module, phase, or instruction on cycle time line %i\n", this->lineNum);
+        return false;
+    }
+    return true;
+};
+
+// Changes one time by the names used in the file - returns false if a name is unknown
+bool CycleTimes::set(const std::string &moduleText, const std::string &phaseText, const std::string &instText, int cycles){
+    int module = -1, phase = -1, inst = -1;
+    for(int m=0; m < NUM_MODULE_TYPES; m++){
+        if(moduleText == moduleNames[m]){
+	    module = m;
+	}
+    }
+    for(int p=0; p < NUM_PHASES; p++){
+        if(phaseText == phaseNames[p]){
+	    phase = p;
+	}
+    }
+    for(int i=0; i < NUM_INSTRUCTIONS; i++){
+        if(instText == instructionNames[i]){
+	    inst = i;
+	}
+    }
+    if(module == -1 || phase == -1 || (inst == -1 && instText != "*")){
+        return false;
+    }
+
+    if(inst == -1){ // Wildcard - every instruction of the module
+        for(int i=0; i < NUM_INSTRUCTIONS; i++){
+	    this->set(static_cast<ModuleType>(module), static_cast<Phase>(phase), static_cast<Instruction>(i), cycles);
+	}
+    }
+    else{
+        this->set(static_cast<ModuleType>(module), static_cast<Phase>(phase), static_cast<Instruction>(inst), cycles);
+    }
+    return true;
+};
+
+// Changes one time and keeps the total for that instruction up to date
+void CycleTimes::set(ModuleType module, Phase phase, Instruction inst, int cycles){
+    this->times[module][phase][inst] = cycles;
+    this->totals[module][inst] = this->times[module][SCHEDULE_PHASE][inst] + this->times[module][EXECUTE_PHASE][inst]
+                               + this->times[module][COMMIT_PHASE][inst];
+};
+
+// Cycles for one phase of an instruction
+int CycleTimes::get(ModuleType module, Phase phase, Instruction inst){
+    return this->times[module][phase][inst];
+};
+
+// Schedule + execute + commit cycles of an instruction
+int CycleTimes::total(ModuleType module, Instruction inst){
+    return this->totals[module][inst];
+};
+
+// Schedule + commit cycles that a module type pays every cycle, even with nothing to run
+int CycleTimes::overhead(ModuleType module){
+    return this->times[module][SCHEDULE_PHASE][NOP] + this->times[module][COMMIT_PHASE][NOP];
+};
+
+// Cycles to read program words and maybe swap programs
+int CycleTimes::reconfigure(ModuleType module, int words, bool swap){
+    return words * this->times[module][LOAD_PHASE][NOP] + (swap ? this->times[module][SWAP_PHASE][NOP] : 0);
+};
+
+// Name of a module type in the cycle time file
+const char * CycleTimes::moduleName(ModuleType module){
+    return moduleNames[module];
+};
+
+// Name of a phase in the cycle time file
+const char * CycleTimes::phaseName(Phase phase){
+    return phaseNames[phase];
+};
+
+// Name of an instruction in the cycle time file
+const char * CycleTimes::instructionName(Instruction inst){
+    return instructionNames[inst];
+};
+
+#endif
@@ -0,0 +1,79 @@
+///////////////////////////////////
+// Cycle Times Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for the cycle time table.
+Cycle times are read from a keyed text file where every line
+gives a module, a phase, an instruction, and a number of cycles:
+
+    # module, phase, instruction, cycles
+    TIA, Execute, ADD, 2
+    Fifo, Schedule, *, 2
+
+A * in the instruction column sets every instruction of that module.
+The Load and Swap phases are the cost of reconfiguring a module - one
+program word read, and one switch to a new program - and don't depend
+on the instruction, so they are set with *.
+The times are stored in a dense table indexed by module type, phase,
+and instruction so that the simulator never searches while it runs.
+*/
+
+#ifndef CYCLETIMES_H
+#define CYCLETIMES_H
+
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<stdlib.h>
+#include<stdio.h>
+using namespace std;
+
+#include"baseclass.h"
+#include"textFile.cpp"
+
+// Types of modules that the simulator runs - used in the cycle time table and the channel wakeup lists
+enum ModuleType{
+    MEM_MODULE = 0,
+    FIFO_MODULE = 1,
+    MULT_MODULE = 2,
+    TIA_MODULE = 3,
+    MAC_MODULE = 4
+};
+#define NUM_MODULE_TYPES 5
+
+// Phases of a module cycle that take time
+enum Phase{
+    SCHEDULE_PHASE = 0,
+    EXECUTE_PHASE = 1,
+    COMMIT_PHASE = 2,
+    LOAD_PHASE = 3,     // Reading one program word
+    SWAP_PHASE = 4      // Switching to a new program
+};
+#define NUM_PHASES 5
+
+class CycleTimes{
+    public:
+	CycleTimes();                                                 // Constructor - every time starts at 0
+	bool load(const char * fileName);                             // Reads a keyed cycle time file - returns false if it can't be opened or has a bad line
+	void set(ModuleType module, Phase phase, Instruction inst, int cycles); // Changes one time, so sweeps don't need a new file
+	bool set(const std::string &module, const std::string &phase, const std::string &inst, int cycles); // Same, by the names in the file - inst can be *
+	int get(ModuleType module, Phase phase, Instruction inst);   // Cycles for one phase of an instruction
+	int total(ModuleType module, Instruction inst);               // Schedule + execute + commit cycles of an instruction
+	int overhead(ModuleType module);                              // Schedule + commit cycles that a module type pays every cycle
+	int reconfigure(ModuleType module, int words, bool swap);     // Cycles to read program words and maybe swap programs
+
+	static const char * moduleName(ModuleType module);            // Name of a module type in the cycle time file
+	static const char * phaseName(Phase phase);                   // Name of a phase in the cycle time file
+	static const char * instructionName(Instruction inst);        // Name of an instruction in the cycle time file
+
+    private:
+	int times[NUM_MODULE_TYPES][NUM_PHASES][NUM_INSTRUCTIONS];    // Cycles for every module, phase, and instruction
+	int totals[NUM_MODULE_TYPES][NUM_INSTRUCTIONS];               // Schedule + execute + commit - kept up to date by set
+	int lineNum;                                                  // Line of the file being parsed - used for warnings
+	bool parseLine(const std::string &line);                      // Parses one line of the file
+};
+
+#endif
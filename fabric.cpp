@@ -0,0 +1,64 @@
+///////////////////////////////////
+// Netlist Timing Model
+// Date   - 10/18/26
+//////////////////////////////////
+#ifndef TIMING_CPP
+#define TIMING_CPP
+
+/*
+This timing model builds its fabric from a netlist file
+instead of wiring it up in C++, so one binary can run any
+topology.  Run it as:
+
+    ./fabric <netlist> [cycle time file] [threads]
+
+Every packet that reaches a watched channel is popped and printed.
+*/
+
+
+#include"timingModel.h"
+using namespace std;
+
+
+int main(int argc, char ** argv){
+    if(argc < 2){
+        printf("Usage: %s <netlist> [cycle time file] [threads]\n", argv[0]);
+	return 1;
+    }
+
+    // Create the simulator, which loads the cycle time file and runs the main loop
+    Simulator sim(argc > 2 ? argv[2] : "cycleTimes.cfg");
+    sim.setEventDriven(true);
+    if(argc > 3){
+        sim.setThreads(atoi(argv[3]));
+    }
+
+    // Build and register every channel and module in the netlist
+    Netlist net;
+    if(!net.load(argv[1], &sim)){
+        return 1;
+    }
+
+    while(!sim.done()){
+	sim.beginCycle();
+	sim.evaluate();
+
+	for(int i=0; i < net.watched.size(); i++){
+	    if(net.watched[i].second->getCanPop()){
+	        printf("Output %s: %i\n", net.watched[i].first.c_str(), net.watched[i].second->get().data);
+		printf("Number of Cycles: %i\n", sim.getTotalTime());
+	    }
+	}
+
+	// Add a cycle's worth of time to the total time
+	sim.endCycle();
+    }
+
+    sim.report();
+
+    return sim.getStopReason() == BAD_CYCLE_TIMES ? 1 : 0;
+}
+
+
+
+#endif
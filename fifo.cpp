@@ -22,34 +22,67 @@ Fifo::Fifo(multiChannel * channelsIn, int size){
     this->c = channelsIn;             // Set internal multichannel
     this->nextIndex = 0;              // Write pointer starts at beginning
     this->baseIndex = 0;              // Read pointer starts at begging
-    this->endLooped = false;          // Writer pointer loop flag starts as false
-    this->beginLooped = false;        // Read pointer loop flag starts as false
-    this->data = new packet [size];   // Internal data storage
-    memset(data, 0, size);            // Zero out initial fifo
+    this->capacity = size;
+    this->highWater = 0;
+    this->burst = false;              // One push or one pop a cycle unless setBurst is called
+    this->pushWidth = 1;
+    this->popWidth = 1;
+
+    // Round the buffer up to a power of two so the pointers wrap with a mask
+    int bufferSize = 1;
+    while(bufferSize < size){
+        bufferSize = bufferSize << 1;
+    }
+    this->mask = bufferSize - 1;
+    packet zero;
+    zero.data = 0;
+    zero.tag = 0;
+    this->data.assign(bufferSize, zero); // Internal data storage, zeroed out
 };
 
 // Method that checks if fifo is not full
 bool Fifo::notFull(){
-    // The fifo is full if the write pointer = read pointer, and they are on the same loop
-    // If they have different loop flags, then the fifo is actually empty
-    if(this->nextIndex == this->baseIndex && this->endLooped != this->beginLooped){
-    	return false;
-    }
-    return true;
+    // The pointers count every push and pop, so their difference is the occupancy even after they wrap
+    return this->getOccupancy() < this->capacity;
 };
 
 // Method that check if fifo is not empty
 bool Fifo::notEmpty(){
-    // The fifo is empty if the write pointer = read pointer, and they are on the same loop
-    // If they have different loop flags, then the fifo is actually full
-    if(this->nextIndex == this->baseIndex && this->endLooped == this->beginLooped){
-        return false;
-    }
-    return true;
+    return this->nextIndex != this->baseIndex;
+};
+
+// Number of packets the fifo can hold
+int Fifo::getCapacity(){
+    return this->capacity;
+};
+
+// Number of packets in the fifo right now
+int Fifo::getOccupancy(){
+    return (int)(this->nextIndex - this->baseIndex);
+};
+
+// Most packets the fifo has held at once
+int Fifo::getHighWater(){
+    return this->highWater;
+};
+
+// Returns the multichannel so the simulator can see our wiring
+multiChannel * Fifo::getChannels(){
+    return this->c;
+};
+
+// Push and pop up to this many packets a cycle, both on the same cycle
+void Fifo::setBurst(int pushWidth, int popWidth){
+    this->burst = true;
+    this->pushWidth = pushWidth < 1 ? 1 : pushWidth;
+    this->popWidth = popWidth < 1 ? 1 : popWidth;
 };
 
 // Schedules a push or pop if possible
 Dynamic_Instruction Fifo::schedule(){
+    if(this->burst){
+        return this->scheduleBurst();
+    }
     // If we have incoming data and space in our fifo, we can push
     if(this->c->channels[F_DATA]->getCanPop() && this->notFull()){
 	Dynamic_Instruction d(PUSH);
@@ -67,32 +100,34 @@ Dynamic_Instruction Fifo::schedule(){
 
 // Executes the push or pop
 Dynamic_Instruction Fifo::execute(Dynamic_Instruction instruction){
-    std::vector<int> uR;
+    if(this->burst){
+        return this->executeBurst(instruction);
+    }
     if(instruction.getInst() == PUSH){
 	packet out = this->c->channels[F_DATA]->get();
-        uR.push_back(out.data); // Grab the data but don't add it to the Fifo yet
-        uR.push_back((int)out.tag.to_ulong()); 
+        instruction.addResult(out.data); // Grab the data but don't add it to the Fifo yet
+        instruction.addResult((int)out.tag.to_ulong()); 
     } else if(instruction.getInst() == POP){
-        uR.push_back(this->data[baseIndex].data); // Grab the data but don't move the pointers yet
-        uR.push_back((int)this->data[baseIndex].tag.to_ulong());
+        instruction.addResult(this->data[baseIndex & mask].data); // Grab the data but don't move the pointers yet
+        instruction.addResult((int)this->data[baseIndex & mask].tag.to_ulong());
     }
-    instruction.setUncommittedResult(uR);
     return instruction;
 };
 
 // Commits the push or pop that is in-flight
 void Fifo::commit(Dynamic_Instruction instruction){
+    if(this->burst){
+        this->commitBurst(instruction);
+	return;
+    }
     if(instruction.getInst() == PUSH){
 	packet out;
 	out.data = instruction.getUncommittedResult()[0];
 	out.tag = instruction.getUncommittedResult()[1];
-        this->data[nextIndex] = out;  // Write to our circular buffer
+        this->data[nextIndex & mask] = out;  // Write to our circular buffer
 	this->nextIndex++;                          // Increment write pointer
-
-	// If we hit the end of the circular buffer, reset the write pointer and flip the loop flag
-	if(this->nextIndex == sizeof(this->data)){  
-	    this->nextIndex = 0;
-	    this->endLooped = !this->endLooped;
+	if(this->getOccupancy() > this->highWater){
+	    this->highWater = this->getOccupancy();
 	}
     }else if(instruction.getInst() == POP){
 	packet out;
@@ -100,14 +135,64 @@ void Fifo::commit(Dynamic_Instruction instruction){
 	out.tag = instruction.getUncommittedResult()[1];
         this->c->channels[F_OUT]->put(out); // Write to our output channel
 	this->baseIndex++;                                 // Increment read pointer
+    }
+};
 
-        // If we hit the end of the circular buffer, reset the write pointer and flip the loop flag
-	if(this->baseIndex == sizeof(this->data)){
-	    this->baseIndex = 0;
-	    this->beginLooped = !this->beginLooped;
-	}
+// Schedules a burst - the results are how many packets to push and how many to pop
+// Both are decided from what the fifo and its channels held when the cycle began, so a burst only pops packets that were already here
+// Pops leave before pushes arrive, so the slots a burst pops are free for the same burst's pushes
+Dynamic_Instruction Fifo::scheduleBurst(){
+    int pop = min(this->popWidth, this->c->channels[F_OUT]->getNumCanPush());
+    pop = min(pop, this->getOccupancy());
+    int push = min(this->pushWidth, this->c->channels[F_DATA]->getNumCanPop());
+    push = min(push, this->capacity - this->getOccupancy() + pop);
+
+    Instruction inst = NOP;
+    if(push > 0 && pop > 0){
+        inst = PUSH_POP;
     }
+    else if(push > 0){
+        inst = PUSH;
+    }
+    else if(pop > 0){
+        inst = POP;
+    }
+    Dynamic_Instruction d(inst);
+    d.addResult(push);
+    d.addResult(pop);
+    return d;
 };
 
+// Executes a burst - grabs the packets but doesn't move the pointers yet
+Dynamic_Instruction Fifo::executeBurst(Dynamic_Instruction instruction){
+    int push = instruction.getUncommittedResult()[0];
+    int pop = instruction.getUncommittedResult()[1];
+    this->incoming.clear();
+    this->outgoing.clear();
+    for(int i=0; i < push; i++){
+        this->incoming.push_back(this->c->channels[F_DATA]->get());
+    }
+    for(int i=0; i < pop; i++){
+        this->outgoing.push_back(this->data[(this->baseIndex + i) & this->mask]);
+    }
+    return instruction;
+};
+
+// Commits a burst - pops leave before pushes arrive, so a full fifo can do both
+void Fifo::commitBurst(Dynamic_Instruction instruction){
+    for(unsigned i=0; i < this->outgoing.size(); i++){
+        this->c->channels[F_OUT]->put(this->outgoing[i]);
+	this->baseIndex++;
+    }
+    for(unsigned i=0; i < this->incoming.size(); i++){
+        this->data[this->nextIndex & this->mask] = this->incoming[i];
+	this->nextIndex++;
+    }
+    if(this->getOccupancy() > this->highWater){
+        this->highWater = this->getOccupancy();
+    }
+    this->outgoing.clear();
+    this->incoming.clear();
+};
 
 #endif
@@ -15,6 +15,7 @@ It includes the other modules and defines the methods.
 
 
 #include<iostream>
+#include<vector>
 using namespace std;
 
 #include "baseclass.cpp"
@@ -30,14 +31,29 @@ class Fifo : public Module {
 	void commit(Dynamic_Instruction instruction);      // Commits the push or pop that is in-flight
 	bool notFull();                            // Method that checks if fifo is not full
 	bool notEmpty();                           // Method that check if fifo is not empty
+	multiChannel * getChannels();              // Returns the multichannel so the simulator can see our wiring
+	int getCapacity();                         // Number of packets the fifo can hold
+	int getOccupancy();                        // Number of packets in the fifo right now
+	int getHighWater();                        // Most packets the fifo has held at once
+	void setBurst(int pushWidth, int popWidth); // Push and pop up to this many packets a cycle, both on the same cycle
 
     private:
-	int nextIndex;        // Internal next available slot in circular buffer
-	int baseIndex;        // Internal first element to push out
-	bool endLooped;       // Flag for if the nextIndex has looped the circular buffer an even or odd number of times
-	bool beginLooped;     // Flag for if the baseIndex has looped the circular buffer an even or odd number of times
+	unsigned nextIndex;   // Count of packets ever pushed - the slot is nextIndex & mask
+	unsigned baseIndex;   // Count of packets ever popped - the slot is baseIndex & mask
+	int capacity;         // Number of packets the fifo can hold
+	int mask;             // Buffer size - 1, the buffer is a power of two at least capacity long so we can wrap with a mask
+	int highWater;        // Most packets the fifo has held at once
+	// Burst mode
+	bool burst;           // Can we push and pop on the same cycle
+	int pushWidth;        // Most packets pushed in a cycle
+	int popWidth;         // Most packets popped in a cycle
+	std::vector<packet> incoming;  // Packets a burst took from F_DATA - waiting for commit, and reused so we don't allocate
+	std::vector<packet> outgoing;  // Packets a burst will put on F_OUT
+	Dynamic_Instruction scheduleBurst();
+	Dynamic_Instruction executeBurst(Dynamic_Instruction instruction);
+	void commitBurst(Dynamic_Instruction instruction);
 	// Some internal packet representations
-	packet * data;        
+	std::vector<packet> data;
 	multiChannel * c; // Pointer to the channels for the fifo module
 };
 
@@ -11,6 +11,8 @@ This is the module for the latency insensitve channel.
 It is designed to allow for any variable number of packets in flight.
 The timing model can decide arbitrary delays for when the channel can push or pop.
 The channel also provides FIFO properties.
+Packets are kept in a ring buffer that is allocated once at construction,
+so put, get, and peek are all constant time.
 */
 
 
@@ -29,30 +31,83 @@ liChannel::liChannel(int maxInFlight){
     this->canPush = true; // Every liChannel should accept at least one packet
     this->canPop = false; // We can't pop yet because no packets are in the system
     this->maxInChannel = maxInFlight;
+
+    // Round the ring buffer up to a power of two that holds maxInFlight packets
+    int size = 1;
+    while(size < maxInFlight){
+        size = size << 1;
+    }
+    this->messages.resize(size);
+    this->mask = size - 1;
+    this->head = 0;
+    this->count = 0;
+    this->occupancy = 0;
+    this->staged = false;
+};
+
+// Destructor
+liChannel::~liChannel(){
 };
 
 // Peeks at a packet in the channel
 packet liChannel::peek(){
-    return this->messages.front();
+    return this->messages[this->head];
 }
 
 // Gets a packet from the channel
 packet liChannel::get(){
-    packet value = this->messages.front();
-    this->messages.erase(this->messages.begin()); // Erase from the front to keep Fifo properties
+    packet value = this->messages[this->head];
+    this->head = (this->head + 1) & this->mask; // Move the head forward to keep Fifo properties
+    this->count--;
     return value;
 };
 
 // Gets number of messages in flight
 int liChannel::numInFlight(){
-    return this->messages.size();
+    return this->count;
 }
 
 // Puts a packet into the channel
 void liChannel::put(packet data){
-    this->messages.push_back(data);
+    if(this->staged){
+        this->pending.push_back(data);
+	return;
+    }
+    if(this->count > this->mask){
+        this->grow();
+    }
+    this->messages[(this->head + this->count) & this->mask] = data;
+    this->count++;
+};
+
+// Doubles the ring buffer if a kernel overfills the channel
+// Kernels are allowed to preload more packets than maxInFlight, so we keep every packet like before
+void liChannel::grow(){
+    std::vector<packet> bigger(this->messages.size() * 2);
+    for(int i=0; i < this->count; i++){
+        bigger[i] = this->messages[(this->head + i) & this->mask];
+    }
+    this->messages.swap(bigger);
+    this->mask = this->messages.size() - 1;
+    this->head = 0;
 };
 
+// While staged, puts wait in pending until flush so only the consumer touches the ring buffer
+void liChannel::stage(bool on){
+    this->staged = on;
+}
+
+// Moves staged puts into the channel in the order they were made
+void liChannel::flush(){
+    bool wasStaged = this->staged;
+    this->staged = false;
+    for(int i=0; i < this->pending.size(); i++){
+        this->put(this->pending[i]);
+    }
+    this->pending.clear();
+    this->staged = wasStaged;
+}
+
 // Checks if we can push to the channel
 bool liChannel::getCanPush(){
     return this->canPush;
@@ -78,5 +133,28 @@ void liChannel::setCanPop(bool update){
     this->canPop = update;
 };
 
+// Method used by timing model to record how many packets were in flight when the cycle began
+// Burst mode modules use this instead of numInFlight so that what the other end does this cycle can't change their burst
+void liChannel::setOccupancy(int update){
+    this->occupancy = update;
+};
+
+// How many packets we can pop this cycle - at least one if canPop is set
+int liChannel::getNumCanPop(){
+    if(!this->canPop){
+        return 0;
+    }
+    return this->occupancy > 1 ? this->occupancy : 1;
+};
+
+// How many packets we can push this cycle - at least one if canPush is set
+int liChannel::getNumCanPush(){
+    if(!this->canPush){
+        return 0;
+    }
+    int space = this->maxInChannel - this->occupancy;
+    return space > 1 ? space : 1;
+};
+
 
 #endif
@@ -16,21 +16,36 @@ struct packet {
 class liChannel{
     public:
 	liChannel(int maxInFlight);    // Constructor that takes the maximum packets in flight for this channel
-	packet get();                  // Gets a packet from the channel
-	packet peek();                 // Peeks at a packet in the channel
-	void put(packet data);         // Puts a packet into the channel
+	virtual ~liChannel();          // Destructor - virtual so spscChannel can be deleted through a liChannel pointer
+	virtual packet get();          // Gets a packet from the channel
+	virtual packet peek();         // Peeks at a packet in the channel
+	virtual void put(packet data); // Puts a packet into the channel
 	bool getCanPush();             // Checks if we can push to the channel
 	bool getCanPop();              // Checks if we can pop from this channel
 	void setCanPush(bool update);  // Method used by timing model to decide if we can push to a channel
 	void setCanPop(bool update);   // Method used by timing model to decide if we can pop from a channel
-	int numInFlight();             // Gets number of messages in flight
+	virtual int numInFlight();     // Gets number of messages in flight
 	int getMax();                  // Returns maxInChannel
+	void setOccupancy(int update); // Method used by timing model to record how many packets were in flight when the cycle began
+	int getNumCanPop();            // How many packets we can pop this cycle
+	int getNumCanPush();           // How many packets we can push this cycle
+	virtual void stage(bool on);   // While staged, puts wait in pending until flush so only the consumer touches the ring buffer
+	virtual void flush();          // Moves staged puts into the channel in the order they were made
+
+    protected:
+	std::vector<packet> messages;  // Internal ring buffer of in order in flight messages
+	int mask;                      // Ring buffer size - 1, the size is a power of two so we can wrap with a mask
+	int maxInChannel;              // Internal variable for the maximum number of packets in a channel
 
     private:
-	std::vector<packet> messages;  // Internal in order in flight messages 
+	void grow();                   // Doubles the ring buffer if a kernel overfills the channel
+	int head;                      // Index of the oldest message in the ring buffer
+	int count;                     // Number of messages in the ring buffer
 	bool canPush;                  // Internal variable for if we can push right now
 	bool canPop;                   // Internal variable for if we can pop right now
-	int maxInChannel;              // Internal variable for the maximum number of packets in a channel
+	int occupancy;                 // Packets in flight when the cycle began
+	bool staged;                   // Are puts being held in pending
+	std::vector<packet> pending;   // Puts made while staged - kept between cycles so we don't reallocate
 };
 
 #endif
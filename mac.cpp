@@ -0,0 +1,94 @@
+///////////////////////////////////
+// Multiply Accumulate Module
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the module for a fused multiply accumulate.
+It takes two inputs and adds their product to an internal sum.
+A packet with its tag set on either input ends the window, so
+its product is added and the sum is sent to the output and cleared.
+This lets a kernel do a whole dot product without sending every
+partial product back through a TIA.
+*/
+
+#ifndef MAC_CPP
+#define MAC_CPP
+
+#include <iostream>
+using namespace std;
+
+#include "baseclass.cpp"
+#include "mac.h"
+
+// Defines for liChannel locations in the multiChannel
+#define MAC_OUT 0
+#define MAC_MULT1 1
+#define MAC_MULT2 2
+
+// Construction that assigns local multiChannel
+MAC::MAC(multiChannel * channelsIn, int updateTag){
+    this->c = channelsIn;
+    this->tagUpdate = updateTag;
+    this->accumulator = 0;
+    this->numWindows = 0;
+};
+
+// Schedule a multiply accumulate command
+Dynamic_Instruction MAC::schedule(){
+    // We need data from both inputs, and room on the output only if this product ends the window
+    if(this->c->channels[MAC_MULT1]->getCanPop() && this->c->channels[MAC_MULT2]->getCanPop()){
+        bool end = this->c->channels[MAC_MULT1]->peek().tag[0] || this->c->channels[MAC_MULT2]->peek().tag[0];
+	if(!end || this->c->channels[MAC_OUT]->getCanPush()){
+	    Dynamic_Instruction d(MULTIPLY_ACCUMULATE);
+	    return d;
+	}
+    }
+    // Otherwise insert a NOP
+    Dynamic_Instruction d(NOP);
+    return d;
+};
+
+// Execute a multiply accumulate command
+Dynamic_Instruction MAC::execute(Dynamic_Instruction instruction){
+    // Calculate the product of the two inputs, but don't add it until commit
+    if(instruction.getInst() == MULTIPLY_ACCUMULATE){
+	packet p1 = this->c->channels[MAC_MULT1]->get();
+	packet p2 = this->c->channels[MAC_MULT2]->get();
+	instruction.addResult(p1.data * p2.data);
+	instruction.addResult(p1.tag[0] || p2.tag[0] ? 1 : 0);
+    }
+    return instruction;
+};
+
+// Add the product to the sum, and send the sum if the window ended
+void MAC::commit(Dynamic_Instruction instruction){
+    if(instruction.getInst() == MULTIPLY_ACCUMULATE){
+	this->accumulator += instruction.getUncommittedResult()[0];
+	if(instruction.getUncommittedResult()[1]){
+	    struct packet sum;
+	    sum.data = this->accumulator;
+	    sum.tag = this->tagUpdate;
+	    this->c->channels[MAC_OUT]->put(sum);
+	    this->accumulator = 0;
+	    this->numWindows++;
+	}
+    }
+};
+
+// Returns the multichannel so the simulator can see our wiring
+multiChannel * MAC::getChannels(){
+    return this->c;
+};
+
+// Sum of the products in the current window
+int MAC::getAccumulator(){
+    return this->accumulator;
+};
+
+// Number of sums sent so far
+int MAC::getNumWindows(){
+    return this->numWindows;
+};
+
+#endif
@@ -0,0 +1,28 @@
+// Header File for the Multiply Accumulate Module
+
+#ifndef MAC_H
+#define MAC_H
+
+#include "liChannel.cpp"
+#include "baseclass.cpp"
+#include "multiChannel.cpp"
+
+
+class MAC: public Module {
+    public:
+	MAC(multiChannel * channelsIn, int updateTag);  // Constructor with multichannel input
+	Dynamic_Instruction schedule();                // Schedule a multiply accumulate instruction
+	Dynamic_Instruction execute(Dynamic_Instruction instruction); // Execute a multiply accumulate instruction
+	void commit(Dynamic_Instruction instruction);  // Commit a multiply accumulate instruction
+	multiChannel * getChannels();                  // Returns the multichannel so the simulator can see our wiring
+	int getAccumulator();                          // Sum of the products in the current window
+	int getNumWindows();                           // Number of sums sent so far
+
+    private:
+	multiChannel *c;        // Internal multichannel representation
+	int tagUpdate;          // Tag put on every sum we send
+	int accumulator;        // Sum of the products in the current window
+	int numWindows;
+};
+
+#endif
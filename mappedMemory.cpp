@@ -0,0 +1,109 @@
+///////////////////////////////////
+// Mapped Memory
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This file maps a file in as main memory with mmap.  A file that
+is shorter than the memory asked for is grown, with zeros, so an
+output memory can be mapped from a file that doesn't exist yet.
+*/
+
+#ifndef MAPPEDMEMORY_CPP
+#define MAPPEDMEMORY_CPP
+
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include"mappedMemory.h"
+
+// Empty Constructor
+MappedMemory::MappedMemory(){
+    this->data = NULL;
+    this->size = 0;
+    this->privateCopy = false;
+};
+
+// Unmaps the file - writes are already in it
+MappedMemory::~MappedMemory(){
+    this->unmap();
+};
+
+// Maps size ints of a file, or the whole file if size is 0 - false on an error
+bool MappedMemory::map(const char * fileName, long long size, bool privateCopy){
+    this->unmap();
+
+    // A private mapping never writes back, so it only needs to read the file, and a missing file is only made when we know its size
+    int fd = open(fileName, privateCopy ? O_RDONLY : (size > 0 ? O_RDWR | O_CREAT : O_RDWR), 0644);
+    if(fd < 0){
+        fprintf(stderr, "Could not open memory file %s\n", fileName);
+	return false;
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0){
+        fprintf(stderr, "Could not read the size of memory file %s\n", fileName);
+	close(fd);
+	return false;
+    }
+    if(size == 0){
+        size = info.st_size / sizeof(int);
+    }
+    if(size <= 0){
+        fprintf(stderr, "Memory file %s is empty and no size was given\n", fileName);
+	close(fd);
+	return false;
+    }
+    size_t bytes = size * sizeof(int);
+    if(!privateCopy && (long long)info.st_size < (long long)bytes && ftruncate(fd, bytes) != 0){
+        fprintf(stderr, "Could not grow memory file %s to %lli ints\n", fileName, size);
+	close(fd);
+	return false;
+    }
+    // Past the end of a short read-only file, a private mapping would fault, so it must hold the whole memory
+    if(privateCopy && (long long)info.st_size < (long long)bytes){
+        fprintf(stderr, "Memory file %s is shorter than %lli ints\n", fileName, size);
+	close(fd);
+	return false;
+    }
+
+    void * mapped = mmap(NULL, bytes, PROT_READ | PROT_WRITE, privateCopy ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file open for us
+    if(mapped == MAP_FAILED){
+        fprintf(stderr, "Could not map memory file %s\n", fileName);
+	return false;
+    }
+    this->data = static_cast<int *>(mapped);
+    this->size = size;
+    this->privateCopy = privateCopy;
+    return true;
+};
+
+// Unmaps the file
+void MappedMemory::unmap(){
+    if(this->data != NULL){
+        munmap(this->data, this->size * sizeof(int));
+	this->data = NULL;
+	this->size = 0;
+    }
+};
+
+// Makes sure every write so far is in the file
+bool MappedMemory::sync(){
+    if(this->data == NULL || this->privateCopy){
+        return true;
+    }
+    return msync(this->data, this->size * sizeof(int), MS_SYNC) == 0;
+};
+
+// Main memory to hand to MemStreams, or NULL if nothing is mapped
+int * MappedMemory::getData(){
+    return this->data;
+};
+
+// Number of ints that are mapped
+long long MappedMemory::getSize(){
+    return this->size;
+};
+
+#endif
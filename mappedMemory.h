@@ -0,0 +1,40 @@
+///////////////////////////////////
+// Mapped Memory Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for main memory that is backed by a file.
+The file is mapped straight into the simulator's address space, so
+a large image or weight file is ready to stream as soon as it is
+mapped, without being read in or copied.  Every word of the file is
+one int of main memory, in the byte order of the machine.
+By default, anything a streamer writes goes back to the file.  A
+private mapping keeps the writes in memory and leaves the file alone.
+*/
+
+#ifndef MAPPEDMEMORY_H
+#define MAPPEDMEMORY_H
+
+#include<stdio.h>
+using namespace std;
+
+class MappedMemory{
+    public:
+	MappedMemory();                        // Empty Constructor
+	~MappedMemory();                       // Unmaps the file - writes are already in it
+	bool map(const char * fileName, long long size, bool privateCopy = false); // Maps size ints of a file, or the whole file if size is 0 - false on an error
+	void unmap();                          // Unmaps the file
+	bool sync();                           // Makes sure every write so far is in the file
+	int * getData();                       // Main memory to hand to MemStreams, or NULL if nothing is mapped
+	long long getSize();                   // Number of ints that are mapped
+
+    private:
+	MappedMemory(const MappedMemory &);    // The mapping can only be undone once, so it can't be copied
+	MappedMemory & operator=(const MappedMemory &);
+	int * data;
+	long long size;
+	bool privateCopy;
+};
+
+#endif
@@ -12,6 +12,14 @@ and ending at the currentEndAddr.  We can also set the stride between
 memory accesses using currentStride. Furthermore, we can set the 
 streamer to either write or read at initialization using the write
 flag and can set the size of the memory accessed using size.
+Instead of base, stride, and end, a streamer can walk up to 4 nested
+loops that each have a count and a stride, like the rows and columns
+of an image tile.  Then a new base on MEM_BASE is all it takes to
+stream the next tile, and it can be sent before this tile is done.
+A streamer given banks claims a port of the bank it reads or writes,
+and the rounds it waits for one are charged by the simulator.  A
+streamer given a cache looks every access up in it first, and only
+the accesses that go out to memory claim a bank port.
 */
 
 #ifndef MEMSTREAM_CPP
@@ -38,6 +46,122 @@ MemStream::MemStream(multiChannel * channelsIn, int beginAddr, int beginStride,
     this->writeMem = write;              // Set whether we write or read
     this->tagUpdate = updateTag;         // Set what the updateTag is if reading from memory
     this->mainMemory = memory;           // Initialize main memory
+    this->windowed = false;              // One read a cycle, back on the same cycle, unless setWindow is called
+    this->window = 1;
+    this->memLatency = 1;
+    this->requestHead = 0;
+    this->numRequests = 0;
+    this->cycle = 0;
+    this->maxOutstanding = 0;
+    this->stalls = 0;
+    this->numLoops = 0;                  // Stream from base to end by stride unless setLoops is called
+    this->loopsDone = false;
+    this->banks = NULL;                  // Memory has no banks unless setBanks is called
+    this->bankWait = 0;
+    this->bankStalls = 0;
+    this->cache = NULL;                  // Every access goes to memory unless setCache is called
+    this->cacheTime = -1;
+    this->cacheHits = 0;
+    this->cacheMisses = 0;
+    this->cacheEvictions = 0;
+};
+
+// Charge accesses to the banks of mainMemory - NULL turns banking off
+void MemStream::setBanks(BankedMemory * banks){
+    this->banks = banks;
+};
+
+// Look accesses up in a cache in front of mainMemory - NULL turns caching off
+void MemStream::setCache(Cache * cache){
+    this->cache = cache;
+};
+
+// Charges this cycle's access to the cache and banks - only accesses that go out to memory claim a bank port
+void MemStream::accessMemory(int addr, bool write){
+    if(this->cache != NULL){
+        CacheAccess access = this->cache->access(addr, write);
+	this->cacheTime = access.latency;
+	this->cacheHits += access.hit ? 1 : 0;
+	this->cacheMisses += access.hit ? 0 : 1;
+	this->cacheEvictions += access.evicted ? 1 : 0;
+	if(!access.toMemory){
+	    return;
+	}
+    }
+    if(this->banks != NULL){
+        this->bankWait = this->banks->access(addr);
+	this->bankStalls += this->bankWait;
+    }
+};
+
+// Walk up to MAX_MEM_LOOPS nested loops from the base address, innermost first
+// A 3x3 window of an image 8 wide is counts {3, 3} and strides {1, 8}
+void MemStream::setLoops(int numLoops, const int * counts, const int * strides){
+    if(numLoops > MAX_MEM_LOOPS){
+        fprintf(stderr, "MemStream can only walk %i nested loops\n", MAX_MEM_LOOPS);
+	numLoops = MAX_MEM_LOOPS;
+    }
+    this->numLoops = numLoops;
+    for(int d=0; d < numLoops; d++){
+        this->loopCount[d] = counts[d];
+	this->loopStride[d] = strides[d];
+    }
+    this->restartLoops();
+};
+
+// Start the loops over at currentBaseAddr
+void MemStream::restartLoops(){
+    this->currentAddr = this->currentBaseAddr;
+    this->loopsDone = false;
+    for(int d=0; d < this->numLoops; d++){
+        this->loopIndex[d] = 0;
+	if(this->loopCount[d] < 1){
+	    this->loopsDone = true;  // A loop that never runs means there is nothing to stream
+	}
+    }
+};
+
+// Are there addresses left in the stream
+bool MemStream::hasMore(){
+    if(this->numLoops > 0){
+        return !this->loopsDone;
+    }
+    return this->currentAddr < this->currentEndAddr;
+};
+
+// Move currentAddr to the next address in the stream
+void MemStream::nextAddr(){
+    if(this->numLoops == 0){
+        this->currentAddr += this->currentStride;
+	return;
+    }
+    // Step the innermost loop, and carry into the next loop out when one finishes
+    for(int d=0; d < this->numLoops; d++){
+        this->loopIndex[d]++;
+	if(this->loopIndex[d] < this->loopCount[d]){
+	    this->currentAddr += this->loopStride[d];
+	    return;
+	}
+	this->currentAddr -= this->loopStride[d] * (this->loopCount[d] - 1);
+	this->loopIndex[d] = 0;
+    }
+    this->loopsDone = true;
+};
+
+// Keep up to outstanding reads in flight, each taking latency cycles to come back
+void MemStream::setWindow(int outstanding, int latency){
+    this->windowed = true;
+    this->window = outstanding < 1 ? 1 : outstanding;
+    this->memLatency = latency < 1 ? 1 : latency;
+    this->requests.assign(this->window, make_pair(0, 0));
+    this->requestHead = 0;
+    this->numRequests = 0;
+};
+
+// Are reads still in flight
+// The simulator keeps a busy streamer awake so its reads come back when no channel changes
+bool MemStream::isBusy(){
+    return this->numRequests > 0;
 };
 
 // Schedule a push or pull from memory
@@ -56,8 +180,16 @@ Dynamic_Instruction MemStream::schedule(){
 	}
     }
 
+    // With nested loops, a new base restarts the loops there once the last pattern is done - the counts and strides stay the same
+    // so a kernel can queue up the next tile while this one is still streaming
+    if(this->numLoops > 0){
+        if(this->loopsDone && this->c->channels[MEM_BASE]->getCanPop()){
+	    this->currentBaseAddr = this->c->channels[MEM_BASE]->get().data;
+	    this->restartLoops();
+	}
+    }
     // Check and set updates if we have updates to our base, stride, and end addresses -- all 3 must be updated together!
-    if(this->c->channels[MEM_BASE]->getCanPop() && this->c->channels[MEM_STRIDE]->getCanPop() && this->c->channels[MEM_END]->getCanPop()){
+    else if(this->c->channels[MEM_BASE]->getCanPop() && this->c->channels[MEM_STRIDE]->getCanPop() && this->c->channels[MEM_END]->getCanPop()){
 	this->currentAddr = this->currentBaseAddr;
 	this->currentBaseAddr = this->c->channels[MEM_BASE]->get().data;
 	this->currentStride = this->c->channels[MEM_STRIDE]->get().data;
@@ -66,13 +198,32 @@ Dynamic_Instruction MemStream::schedule(){
     }
 
 
+    // A windowed reader issues a read whenever the window has room, and sends the oldest read once it is back
+    // Issuing doesn't need room on MEM_OUT, only sending does, so reads keep going out while the output is full
+    if(this->windowed && this->writeMem == false){
+        bool more = this->hasMore() && this->running == true;
+        bool issue = more && this->numRequests < this->window;
+	bool back = this->numRequests > 0 && this->requests[this->requestHead].first <= this->cycle;
+	bool send = back && this->c->channels[MEM_OUT]->getCanPush();
+	if((back && !send) || (more && !issue)){
+	    this->stalls++;
+	}
+	if(issue || send){
+	    Dynamic_Instruction d(STREAM);
+	    d.addResult(issue ? 1 : 0);
+	    return d;
+	}
+	Dynamic_Instruction d(NOP);
+	return d;
+    }
+
     // If we are a reader, make sure we are running, haven't passed our end addres, and can write out the data we grab
-    if(this->c->channels[MEM_OUT]->getCanPush() && (this->currentAddr < this->currentEndAddr) && this->running == true && this->writeMem == false){
+    if(this->c->channels[MEM_OUT]->getCanPush() && this->hasMore() && this->running == true && this->writeMem == false){
         Dynamic_Instruction d(STREAM);
 	return d;
     }
     // If we are a writer, make sure we are running, havend passed our end address, and we can grab the data we need to write
-    if(this->c->channels[MEM_DATA]->getCanPop() && this->currentAddr < this->currentEndAddr && this->running == true && this->writeMem == true){
+    if(this->c->channels[MEM_DATA]->getCanPop() && this->hasMore() && this->running == true && this->writeMem == true){
 	Dynamic_Instruction d(WRITE_MEM);
         return d;
     }
@@ -83,23 +234,50 @@ Dynamic_Instruction MemStream::schedule(){
 
 // Send another memory value or receive another memory value to write back
 Dynamic_Instruction MemStream::execute(Dynamic_Instruction instruction){
-    std::vector<int> uR;
+    this->bankWait = 0;
+    this->cacheTime = -1;
+    if(this->windowed && this->writeMem == false){
+        // Issue the read - its data comes back memLatency - 1 cycles from now
+        if(instruction.getInst() == STREAM && instruction.getUncommittedResult()[0] == 1){
+	    this->accessMemory(this->currentAddr, false);
+	    this->requests[(this->requestHead + this->numRequests) % this->window] = make_pair(this->cycle + this->memLatency - 1, this->mainMemory[this->currentAddr]);
+	    this->numRequests++;
+	    this->nextAddr();
+	    if(this->numRequests > this->maxOutstanding){
+	        this->maxOutstanding = this->numRequests;
+	    }
+	}
+	return instruction;
+    }
     if(instruction.getInst() == STREAM){
-        uR.push_back(this->mainMemory[this->currentAddr]);  // Grab our data from main memory
-        instruction.setUncommittedResult(uR);
-	this->currentAddr += this->currentStride;                   // Increment current address
+        this->accessMemory(this->currentAddr, false);
+        instruction.addResult(this->mainMemory[this->currentAddr]);  // Grab our data from main memory
+	this->nextAddr();                                           // Increment current address
     }
     else if(instruction.getInst() == WRITE_MEM){
-	uR.push_back(this->c->channels[MEM_DATA]->get().data); // Get the data from the channel
-        instruction.setUncommittedResult(uR);
+	instruction.addResult(this->c->channels[MEM_DATA]->get().data); // Get the data from the channel
 	this->writeAddress = this->currentAddr;                        // Grab address to write to
-	this->currentAddr += this->currentStride;                      // Increment current address
+	this->accessMemory(this->writeAddress, true);                  // The write lands at commit, but it is charged now
+	this->nextAddr();                                              // Increment current address
     }
     return instruction;
 };
 
 // Commit the push or pull from memory
 void MemStream::commit(Dynamic_Instruction instruction){
+    if(this->windowed && this->writeMem == false){
+        // Reads come back in the order they were issued
+        if(this->numRequests > 0 && this->requests[this->requestHead].first <= this->cycle && this->c->channels[MEM_OUT]->getCanPush()){
+	    struct packet send;
+	    send.data = this->requests[this->requestHead].second;
+	    send.tag = this->tagUpdate;
+	    this->c->channels[MEM_OUT]->put(send);
+	    this->requestHead = (this->requestHead + 1) % this->window;
+	    this->numRequests--;
+	}
+	this->cycle++;
+	return;
+    }
     if(instruction.getInst() == STREAM){
 	struct packet send;                    // Create a packet to send to the system
 	send.data = instruction.getUncommittedResult()[0];       // Input the data from memory to the packet
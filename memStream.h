@@ -9,12 +9,18 @@
 #define MEMSTREAM_H
 
 #include<iostream>
+#include<vector>
 using namespace std;
 
+// Most nested loops a streamer can walk
+#define MAX_MEM_LOOPS 4
+
 #include"baseclass.cpp"
 #include"liChannel.h"
 #include"liChannel.cpp"
 #include"multiChannel.cpp"
+#include"bankedMemory.cpp"
+#include"cache.cpp"
 
 class MemStream : public Module {
     public:
@@ -32,6 +38,43 @@ class MemStream : public Module {
 	bool running;                           // bool which states if we are currently running or not
 	bool writeMem;                          // bool whcih determines if we are a writing or reading memStreamer
 	int tagUpdate;                          // If we are writing out, what should the tag be?
+
+	// Outstanding request window for readers
+	void setWindow(int outstanding, int latency); // Keep up to outstanding reads in flight, each taking latency cycles to come back
+	bool isBusy();                          // Are reads still in flight
+	bool windowed;                          // Are reads issued ahead through the window
+	int window;                             // Most reads in flight at once
+	int memLatency;                         // Cycles from a read being issued to its data coming back - 1 comes back on the same cycle
+	int cycle;                              // Cycles this streamer has run
+	std::vector<pair<int, int> > requests;  // Ring of window slots - reads in flight, the cycle their data is back and the data
+	int requestHead;                        // Slot of the oldest read
+	int numRequests;                        // Reads in the ring
+	int maxOutstanding;                     // Most reads that were in flight at once
+	int stalls;                             // Cycles a read was back but MEM_OUT was full, or the window was full
+
+	// Nested loop addressing
+	void setLoops(int numLoops, const int * counts, const int * strides); // Walk up to MAX_MEM_LOOPS nested loops from the base address, innermost first
+	void restartLoops();                    // Start the loops over at currentBaseAddr
+	bool hasMore();                         // Are there addresses left in the stream
+	void nextAddr();                        // Move currentAddr to the next address in the stream
+	int numLoops;                           // 0 streams from base to end by stride
+	int loopCount[MAX_MEM_LOOPS];           // Trips around each loop
+	int loopStride[MAX_MEM_LOOPS];          // Address step of each loop
+	int loopIndex[MAX_MEM_LOOPS];           // Where we are in each loop
+	bool loopsDone;                         // Set once the outermost loop finishes
+
+	// Banked and cached main memory
+	void setBanks(BankedMemory * banks);    // Charge accesses to the banks of mainMemory - NULL turns banking off
+	void setCache(Cache * cache);           // Look accesses up in a cache in front of mainMemory - NULL turns caching off
+	void accessMemory(int addr, bool write); // Charges this cycle's access to the cache and banks
+	BankedMemory * banks;                   // Banks of mainMemory, or NULL if every access is free of conflicts
+	int bankWait;                           // Rounds this cycle's access waited for its bank
+	int bankStalls;                         // Rounds waited for banks over the whole run
+	Cache * cache;                          // Cache in front of mainMemory, or NULL
+	int cacheTime;                          // Cycles the cache took for this cycle's access - -1 if it wasn't cached
+	int cacheHits;                          // This streamer's share of the cache's hits, misses, and evictions
+	int cacheMisses;
+	int cacheEvictions;
 };
 
 #endif
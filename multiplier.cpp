@@ -28,10 +28,46 @@ using namespace std;
 Multiplier::Multiplier(multiChannel * channelsIn, int updateTag){
     this->c = channelsIn;
     this->tagUpdate = updateTag;
+    this->pipelined = false;       // One product a cycle, finished on the cycle it starts, unless setPipeline is called
+    this->latency = 1;
+    this->interval = 1;
+    this->issueWait = 0;
+    this->cycle = 0;
+    this->inFlightHead = 0;
+    this->numInFlight = 0;
+    this->numIssued = 0;
+    this->stalls = 0;
+    this->stalled = false;
+    this->occupancySum = 0;
+};
+
+// Pipeline the multiplier - a product takes latency cycles and a new one can start every interval cycles
+void Multiplier::setPipeline(int latency, int interval){
+    this->pipelined = true;
+    this->latency = latency < 1 ? 1 : latency;
+    this->interval = interval < 1 ? 1 : interval;
+    // schedule never lets more than latency products into the pipeline, so latency slots are enough
+    this->inFlight.assign(this->latency, make_pair(0, packet()));
+    this->inFlightHead = 0;
+    this->numInFlight = 0;
 };
 
 // Schedule a multiply command
 Dynamic_Instruction Multiplier::schedule(){
+    if(this->pipelined){
+        // A product can start if both inputs are here, the last one started an interval ago, and a stage is free
+	// The output is only needed when the product leaves, so a full output channel stalls the pipeline instead
+	bool inputs = this->c->channels[M_MULT1]->getCanPop() && this->c->channels[M_MULT2]->getCanPop();
+	if(inputs && this->issueWait == 0 && this->numInFlight < this->latency){
+	    Dynamic_Instruction d(MULTIPLY);
+	    return d;
+	}
+	if(inputs){
+	    this->stalled = true;
+	}
+	Dynamic_Instruction d(NOP);
+	return d;
+    }
     // We need to check if we can push to our output channel and grab data from both inputs
     if(this->c->channels[M_OUT]->getCanPush() && this->c->channels[M_MULT1]->getCanPop() && this->c->channels[M_MULT2]->getCanPop()){
         Dynamic_Instruction d(MULTIPLY);
@@ -46,18 +82,49 @@ Dynamic_Instruction Multiplier::schedule(){
 Dynamic_Instruction Multiplier::execute(Dynamic_Instruction instruction){
     // Calculate the product of the two inputs
     if(instruction.getInst() == MULTIPLY){
-	std::vector<int> uR;
 	struct packet p;
 	p = this->c->channels[M_MULT1]->get();
-	uR.push_back(p.data * this->c->channels[M_MULT2]->get().data);
-	uR.push_back((int)p.tag.to_ulong());
-        instruction.setUncommittedResult(uR);
+	instruction.addResult(p.data * this->c->channels[M_MULT2]->get().data);
+	instruction.addResult((int)p.tag.to_ulong());
     }
     return instruction;
 };
 
 // Create a packet and send it to the output
 void Multiplier::commit(Dynamic_Instruction instruction){
+    if(this->pipelined){
+        if(instruction.getInst() == MULTIPLY){
+	    struct packet product;
+	    product.data = instruction.getUncommittedResult()[0];
+	    product.tag = instruction.getUncommittedResult()[1];
+	    this->inFlight[(this->inFlightHead + this->numInFlight) % this->latency] = make_pair(this->cycle + this->latency - 1, product);
+	    this->numInFlight++;
+	    this->issueWait = this->interval;
+	    this->numIssued++;
+	}
+	// The oldest product leaves once it is done and there is room for it
+	if(this->numInFlight > 0 && this->inFlight[this->inFlightHead].first <= this->cycle){
+	    if(this->c->channels[M_OUT]->getCanPush()){
+	        this->c->channels[M_OUT]->put(this->inFlight[this->inFlightHead].second);
+		this->inFlightHead = (this->inFlightHead + 1) % this->latency;
+		this->numInFlight--;
+	    }
+	    else{
+	        this->stalled = true;
+	    }
+	}
+	// A cycle where a product couldn't start and another couldn't leave is still one stalled cycle
+	if(this->stalled){
+	    this->stalls++;
+	    this->stalled = false;
+	}
+	this->occupancySum += this->numInFlight;
+	this->cycle++;
+	if(this->issueWait > 0){
+	    this->issueWait--;
+	}
+	return;
+    }
     if(instruction.getInst() == MULTIPLY){
 	struct packet product;
 	product.data = instruction.getUncommittedResult()[0];
@@ -66,4 +133,35 @@ void Multiplier::commit(Dynamic_Instruction instruction){
     }
 };
 
+// Returns the multichannel so the simulator can see our wiring
+multiChannel * Multiplier::getChannels(){
+    return this->c;
+};
+
+// Are products in flight, or are we waiting out the initiation interval
+// The simulator keeps a busy multiplier awake so its pipeline keeps moving when no channel changes
+bool Multiplier::isBusy(){
+    return this->numInFlight > 0 || this->issueWait > 0;
+};
+
+// Products in the pipeline right now
+int Multiplier::getNumInFlight(){
+    return this->numInFlight;
+};
+
+// Products started so far
+int Multiplier::getNumIssued(){
+    return this->numIssued;
+};
+
+// Cycles a product was ready to start or leave but couldn't
+int Multiplier::getStalls(){
+    return this->stalls;
+};
+
+// Average products in flight per cycle
+double Multiplier::getAverageOccupancy(){
+    return this->cycle > 0 ? (double)this->occupancySum / this->cycle : 0;
+};
+
 #endif
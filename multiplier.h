@@ -3,6 +3,9 @@
 #ifndef MULTIPLIER_H
 #define MULTIPLIER_H
 
+#include<vector>
+using namespace std;
+
 #include "liChannel.cpp"
 #include "baseclass.cpp"
 #include "multiChannel.cpp"
@@ -14,10 +17,31 @@ class Multiplier: public Module {
 	Dynamic_Instruction schedule();                // Schedule a multiply instruction
 	Dynamic_Instruction execute(Dynamic_Instruction instruction); // Execute a multiply instruction
 	void commit(Dynamic_Instruction instruction);  // Commit a multiply instruction
+	multiChannel * getChannels();                  // Returns the multichannel so the simulator can see our wiring
+	void setPipeline(int latency, int interval);   // Pipeline the multiplier - a product takes latency cycles and a new one can start every interval cycles
+	bool isBusy();                                 // Are products in flight, or are we waiting out the initiation interval
+	int getNumInFlight();                          // Products in the pipeline right now
+	int getNumIssued();                            // Products started so far
+	int getStalls();                               // Cycles a product was ready to start or leave but couldn't
+	double getAverageOccupancy();                  // Average products in flight per cycle
 
     private:
 	multiChannel *c;        // Internal multichannel representation               
 	int tagUpdate;
+
+	// Pipelining
+	bool pipelined;
+	int latency;            // Cycles from a product starting to leaving - 1 leaves on the cycle it starts
+	int interval;           // Cycles between products starting
+	int issueWait;          // Cycles left before another product can start
+	int cycle;              // Cycles this multiplier has run
+	std::vector<pair<int, packet> > inFlight; // Ring of latency slots - products in the pipeline and the cycle they finish
+	int inFlightHead;       // Slot of the oldest product
+	int numInFlight;        // Products in the ring
+	int numIssued;
+	int stalls;
+	bool stalled;           // Did a product fail to start or leave this cycle
+	long long occupancySum; // Products in flight added up over every cycle, for the average
 };
 
 #endif
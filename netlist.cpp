@@ -0,0 +1,688 @@
+///////////////////////////////////
+// Netlist
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This file builds the fabric described by a netlist file.
+Each line makes a channel, memory, or module, wires it up,
+and registers it with the simulator.
+*/
+
+#ifndef NETLIST_CPP
+#define NETLIST_CPP
+
+#include"netlist.h"
+
+// Arguments that each module type accepts
+static const char * fifoArgs[] = {"size", "push", "pop", "out", "data"};
+static const char * memArgs[] = {"memory", "base", "stride", "end", "write", "tag", "window", "latency", "loops", "start", "out", "data", "setBase", "setStride", "setEnd"};
+static const char * multArgs[] = {"tag", "latency", "interval", "out", "mult1", "mult2"};
+static const char * macArgs[] = {"tag", "out", "mult1", "mult2"};
+static const char * tiaArgs[] = {"preds", "regs", "width", "policy", "depth", "help", "in", "out", "program"};
+static const char * channelArgs[] = {"capacity"};
+static const char * memoryArgs[] = {"file", "private", "banks", "interleave", "ports", "cache", "ways", "line", "policy", "writeback", "hit", "miss"};
+
+// Empty Constructor
+Netlist::Netlist(){
+    this->sim = NULL;
+    this->lineNum = 0;
+    this->privateMemories = false;
+};
+
+// Frees every channel, memory, and module the netlist built
+Netlist::~Netlist(){
+    for(int i=0; i < this->fifos.size(); i++){
+        delete this->fifos[i];
+    }
+    for(int i=0; i < this->mems.size(); i++){
+        delete this->mems[i];
+    }
+    for(int i=0; i < this->mults.size(); i++){
+        delete this->mults[i];
+    }
+    for(int i=0; i < this->macs.size(); i++){
+        delete this->macs[i];
+    }
+    for(int i=0; i < this->tias.size(); i++){
+        delete this->tias[i];
+    }
+    for(int i=0; i < this->multiChannels.size(); i++){
+        delete this->multiChannels[i];
+    }
+    for(int i=0; i < this->channels.size(); i++){
+        delete this->channels[i];
+    }
+    for(int i=0; i < this->memories.size(); i++){
+        delete [] this->memories[i];
+    }
+    // Flush what the streamers wrote out to the memory files before they are unmapped
+    for(int i=0; i < this->mappedMemories.size(); i++){
+        if(!this->mappedMemories[i]->sync()){
+	    fprintf(stderr, "Could not write a mapped memory back to its file\n");
+	}
+        delete this->mappedMemories[i];
+    }
+    for(int i=0; i < this->bankedMemories.size(); i++){
+        delete this->bankedMemories[i];
+    }
+    for(int i=0; i < this->caches.size(); i++){
+        delete this->caches[i];
+    }
+};
+
+// Builds the fabric in a netlist file and registers it with sim - false on an error
+bool Netlist::load(const char * fileName, Simulator * sim){
+    std::ifstream data(fileName);
+    if(!data.is_open()){
+        fprintf(stderr, "Could not open netlist %s\n", fileName);
+        return false;
+    }
+    this->sim = sim;
+
+    std::string line;
+    this->lineNum = 0;
+    while(readLine(data, line)){
+        this->lineNum++;
+	if(!this->parseLine(line)){
+	    return false;
+	}
+    }
+
+    // An override that no line used is a typo or a name that isn't in this netlist, and would silently change nothing
+    bool ok = true;
+    for(std::map<std::string, std::string>::iterator it = this->overrides.begin(); it != this->overrides.end(); it++){
+        if(this->usedOverrides.count(it->first) == 0){
+	    fprintf(stderr, "Netlist %s has no argument for %s\n", fileName, it->first.c_str());
+	    ok = false;
+	}
+    }
+    return ok;
+};
+
+// Overrides an argument before load, like f1.size or *.capacity
+void Netlist::set(const std::string &key, const std::string &value){
+    this->overrides[key] = value;
+};
+
+// Maps every memory file as if it were private=1 - set before load
+void Netlist::setPrivateMemories(bool privateMemories){
+    this->privateMemories = privateMemories;
+};
+
+// Name of a module in the order it was registered with the simulator
+std::string Netlist::getName(ModuleType type, int index){
+    if(index < 0 || index >= (int)this->names[type].size()){
+        return "";
+    }
+    return this->names[type][index];
+};
+
+// Replaces arguments with any that were set before load - a named override beats a * one
+void Netlist::applyOverrides(const std::string &name, std::map<std::string, std::string> &args, const char * allowed[], int numAllowed){
+    for(int i=0; i < numAllowed; i++){
+        std::map<std::string, std::string>::iterator it = this->overrides.find(std::string("*.") + allowed[i]);
+	if(it != this->overrides.end()){
+	    args[allowed[i]] = it->second;
+	    this->usedOverrides.insert(it->first);
+	}
+	it = this->overrides.find(name + "." + allowed[i]);
+	if(it != this->overrides.end()){
+	    args[allowed[i]] = it->second;
+	    this->usedOverrides.insert(it->first);
+	}
+    }
+};
+
+// Prints an error for the current line and returns false
+bool Netlist::error(const char * message){
+    fprintf(stderr, "Netlist line %i: %s\n", this->lineNum, message);
+    return false;
+};
+
+// Reads key=value arguments and makes sure each key is one the module knows about
+bool Netlist::parseArgs(std::stringstream &tokens, std::map<std::string, std::string> &args, const char * allowed[], int numAllowed){
+    std::string token;
+    while(tokens >> token){
+        size_t split = token.find('=');
+	if(split == std::string::npos){
+	    return this->error(("expected key=value but found " + token).c_str());
+	}
+	std::string key = token.substr(0, split);
+	bool known = false;
+	for(int i=0; i < numAllowed; i++){
+	    if(key == allowed[i]){
+	        known = true;
+	    }
+	}
+	if(!known){
+	    return this->error(("unknown argument " + key).c_str());
+	}
+	args[key] = token.substr(split + 1);
+    }
+    return true;
+};
+
+// Channel bound to a port, or a new unconnected channel if the port isn't given
+liChannel * Netlist::port(std::map<std::string, std::string> &args, const char * key, bool &ok){
+    if(args.count(key) == 0){
+        liChannel * unconnected = new liChannel(1);
+	this->channels.push_back(unconnected);
+	this->sim->addChannel(unconnected);
+	return unconnected;
+    }
+    liChannel * chan = this->getChannel(args[key]);
+    if(chan == NULL){
+        ok = this->error(("unknown channel " + args[key]).c_str());
+    }
+    return chan;
+};
+
+// Adds a comma separated list of channels to a multiChannel in order
+bool Netlist::portList(std::map<std::string, std::string> &args, const char * key, multiChannel * chans){
+    if(args.count(key) == 0){
+        return true;
+    }
+    std::stringstream list(args[key]);
+    std::string name;
+    while(std::getline(list, name, ',')){
+        liChannel * chan = this->getChannel(name);
+	if(chan == NULL){
+	    return this->error(("unknown channel " + name).c_str());
+	}
+	chans->add(chan);
+    }
+    return true;
+};
+
+// Parses one line of the file
+bool Netlist::parseLine(const std::string &line){
+    // Drop comments
+    std::string text = line.substr(0, line.find('#'));
+    std::stringstream tokens(text);
+    std::string keyword, name;
+    if(!(tokens >> keyword)){
+        return true;  // Blank line
+    }
+    if(!(tokens >> name)){
+        return this->error(("missing name after " + keyword).c_str());
+    }
+
+    std::map<std::string, std::string> args;
+    bool ok = true;
+
+    // Modules of every type share one set of names
+    if(keyword == "fifo" || keyword == "memstream" || keyword == "multiplier" || keyword == "mac" || keyword == "tia"){
+        if(this->moduleNames.count(name) > 0){
+	    return this->error(("duplicate name " + name).c_str());
+	}
+	this->moduleNames.insert(name);
+    }
+
+    if(keyword == "channel"){
+        int capacity;
+	if(tokens >> args["capacity"]){
+	    this->applyOverrides(name, args, channelArgs, 1);
+	}
+	if(args.count("capacity") == 0 || !parseInt(args["capacity"], capacity) || capacity < 1){
+	    return this->error("channel needs a capacity of at least 1");
+	}
+	if(this->channelNames.count(name) > 0){
+	    return this->error(("channel " + name + " is declared twice").c_str());
+	}
+	std::string kind;
+	liChannel * chan;
+	if(tokens >> kind){
+	    if(kind != "spsc"){
+	        return this->error(("unknown channel kind " + kind).c_str());
+	    }
+	    chan = new spscChannel(capacity);
+	}
+	else{
+	    chan = new liChannel(capacity);
+	}
+	this->channels.push_back(chan);
+	this->channelNames[name] = chan;
+	this->sim->addChannel(chan);
+    }
+    else if(keyword == "memory"){
+        std::string sizeText;
+	int size;
+	if(!(tokens >> sizeText) || !parseInt(sizeText, size) || size < 0){
+	    return this->error("memory needs a size");
+	}
+	if(!this->parseArgs(tokens, args, memoryArgs, sizeof(memoryArgs) / sizeof(memoryArgs[0]))){
+	    return false;
+	}
+	this->applyOverrides(name, args, memoryArgs, sizeof(memoryArgs) / sizeof(memoryArgs[0]));
+	if(this->memoryNames.count(name) > 0){
+	    return this->error(("memory " + name + " is declared twice").c_str());
+	}
+	if(args.count("file") == 0){
+	    if(size < 1){
+	        return this->error("memory needs a size of at least 1");
+	    }
+	    int * memory = new int [size];
+	    memset(memory, 0, size * sizeof(int));
+	    this->memories.push_back(memory);
+	    this->memoryNames[name] = make_pair(memory, size);
+	}
+	else{
+	    // Backed by a file, so the memory can be much bigger than what we'd want to read in
+	    int privateCopy = 0;
+	    if(args.count("private") > 0 && !parseInt(args["private"], privateCopy)){
+	        return this->error("private needs to be 0 or 1");
+	    }
+	    MappedMemory * mapped = new MappedMemory();
+	    this->mappedMemories.push_back(mapped);
+	    if(!mapped->map(args["file"].c_str(), size, privateCopy != 0 || this->privateMemories)){
+	        return this->error("could not map the memory file");
+	    }
+	    // Streamers address memory with ints, so the file can hold up to 2^31 - 1 of them
+	    if(mapped->getSize() > 0x7fffffff){
+	        return this->error("memory file is too big for int addresses");
+	    }
+	    this->memoryNames[name] = make_pair(mapped->getData(), (int)mapped->getSize());
+	}
+	// Giving any of banks, interleave, or ports makes every streamer on this memory contend for bank ports
+	if(args.count("banks") > 0 || args.count("interleave") > 0 || args.count("ports") > 0){
+	    int numBanks = 1, interleave = 1, ports = 1;
+	    if((args.count("banks") > 0 && !parseInt(args["banks"], numBanks)) ||
+	       (args.count("interleave") > 0 && !parseInt(args["interleave"], interleave)) ||
+	       (args.count("ports") > 0 && !parseInt(args["ports"], ports))){
+	        return this->error("memory banks, interleave, and ports must be numbers");
+	    }
+	    BankedMemory * banks = new BankedMemory(this->memoryNames[name].first, numBanks, interleave, ports);
+	    this->bankedMemories.push_back(banks);
+	    this->bankNames[name] = banks;
+	    this->sim->addBankedMemory(banks);
+	}
+	// Giving a cache size puts a cache in front of the memory that every streamer on it shares
+	if(args.count("cache") > 0){
+	    int size = 0, ways = 1, line = 1, writeBack = 1, hit = 1, miss = 10;
+	    if(!parseInt(args["cache"], size) ||
+	       (args.count("ways") > 0 && !parseInt(args["ways"], ways)) ||
+	       (args.count("line") > 0 && !parseInt(args["line"], line)) ||
+	       (args.count("writeback") > 0 && !parseInt(args["writeback"], writeBack)) ||
+	       (args.count("hit") > 0 && !parseInt(args["hit"], hit)) ||
+	       (args.count("miss") > 0 && !parseInt(args["miss"], miss))){
+	        return this->error("memory cache, ways, line, writeback, hit, and miss must be numbers");
+	    }
+	    if(size < 1){
+	        return this->error("memory cache needs a size of at least 1");
+	    }
+	    ReplacementPolicy policy = LRU_REPLACE;
+	    if(args.count("policy") > 0){
+	        if(args["policy"] == "FIFO"){
+		    policy = FIFO_REPLACE;
+		}
+		else if(args["policy"] == "RANDOM"){
+		    policy = RANDOM_REPLACE;
+		}
+		else if(args["policy"] != "LRU"){
+		    return this->error(("unknown replacement policy " + args["policy"]).c_str());
+		}
+	    }
+	    Cache * cache = new Cache(size, ways, line, policy, writeBack != 0, hit, miss);
+	    this->caches.push_back(cache);
+	    this->cacheNames[name] = cache;
+	    this->sim->addCache(cache);
+	}
+    }
+    else if(keyword == "fill"){
+        if(this->memoryNames.count(name) == 0){
+	    return this->error(("unknown memory " + name).c_str());
+	}
+	pair<int *, int> memory = this->memoryNames[name];
+	std::string token;
+	int addr, value;
+	if(!(tokens >> token) || !parseInt(token, addr) || addr < 0){
+	    return this->error("fill needs a starting address");
+	}
+	while(tokens >> token){
+	    if(!parseInt(token, value)){
+	        return this->error(("bad fill value " + token).c_str());
+	    }
+	    if(addr >= memory.second){
+	        return this->error("fill runs past the end of memory");
+	    }
+	    memory.first[addr++] = value;
+	}
+    }
+    else if(keyword == "packet"){
+        liChannel * chan = this->getChannel(name);
+	if(chan == NULL){
+	    return this->error(("unknown channel " + name).c_str());
+	}
+	std::string dataText, tagText;
+	packet p;
+	p.data = -1;
+	p.tag = 0;
+	if(!(tokens >> dataText)){
+	    return this->error("packet needs data");
+	}
+	// Data can be an instruction name, like START_STREAM for a memory streamer
+	for(int i=0; i < NUM_INSTRUCTIONS; i++){
+	    if(dataText == CycleTimes::instructionName(static_cast<Instruction>(i))){
+	        p.data = i;
+		dataText.clear();
+	    }
+	}
+	if(dataText.size() > 0 && !parseInt(dataText, p.data)){
+	    return this->error(("bad packet data " + dataText).c_str());
+	}
+	int tag = 0;
+	if(tokens >> tagText && (!parseInt(tagText, tag) || tag < 0 || tag > 1)){
+	    return this->error("packet tag must be 0 or 1");
+	}
+	p.tag = tag;
+	chan->put(p);
+    }
+    else if(keyword == "watch"){
+        liChannel * chan = this->getChannel(name);
+	if(chan == NULL){
+	    return this->error(("unknown channel " + name).c_str());
+	}
+	this->watched.push_back(make_pair(name, chan));
+    }
+    else if(keyword == "fifo"){
+        if(!this->parseArgs(tokens, args, fifoArgs, sizeof(fifoArgs) / sizeof(fifoArgs[0]))){
+	    return false;
+	}
+	this->applyOverrides(name, args, fifoArgs, sizeof(fifoArgs) / sizeof(fifoArgs[0]));
+	int size = 0;
+	if(args.count("size") == 0 || !parseInt(args["size"], size) || size < 1){
+	    return this->error("fifo needs size=<n>");
+	}
+	// Ports go in the order of the F_ defines
+	multiChannel * chans = new multiChannel();
+	this->multiChannels.push_back(chans);
+	chans->add(this->port(args, "out", ok));
+	chans->add(this->port(args, "data", ok));
+	if(!ok){
+	    return false;
+	}
+	Fifo * fifo = new Fifo(chans, size);
+	// Giving either width puts the fifo in burst mode
+	if(args.count("push") > 0 || args.count("pop") > 0){
+	    int push = 1, pop = 1;
+	    if((args.count("push") > 0 && !parseInt(args["push"], push)) ||
+	       (args.count("pop") > 0 && !parseInt(args["pop"], pop))){
+	        delete fifo;
+		return this->error("fifo push and pop must be numbers");
+	    }
+	    fifo->setBurst(push, pop);
+	}
+	this->fifos.push_back(fifo);
+	this->fifoNames[name] = fifo;
+	this->sim->addFifo(fifo);
+	this->names[FIFO_MODULE].push_back(name);
+    }
+    else if(keyword == "memstream"){
+        if(!this->parseArgs(tokens, args, memArgs, sizeof(memArgs) / sizeof(memArgs[0]))){
+	    return false;
+	}
+	this->applyOverrides(name, args, memArgs, sizeof(memArgs) / sizeof(memArgs[0]));
+	if(args.count("memory") == 0 || this->memoryNames.count(args["memory"]) == 0){
+	    return this->error("memstream needs memory=<a declared memory>");
+	}
+	int base = 0, stride = 1, end = 0, write = 0, tag = 0;
+	if((args.count("base") > 0 && !parseInt(args["base"], base)) ||
+	   (args.count("stride") > 0 && !parseInt(args["stride"], stride)) ||
+	   (args.count("end") > 0 && !parseInt(args["end"], end)) ||
+	   (args.count("write") > 0 && !parseInt(args["write"], write)) ||
+	   (args.count("tag") > 0 && !parseInt(args["tag"], tag))){
+	    return this->error("memstream base, stride, end, write, and tag must be numbers");
+	}
+	// Like fill, a stream has to stay inside its memory - loops check their own extent below
+	int memSize = this->memoryNames[args["memory"]].second;
+	if(base < 0 || base > memSize){
+	    return this->error("memstream base is outside its memory");
+	}
+	if(args.count("loops") == 0 && stride < 1){
+	    return this->error("memstream stride must be at least 1");
+	}
+	if(args.count("loops") == 0 && end > memSize){
+	    return this->error("memstream end is past the end of its memory");
+	}
+	// Ports go in the order of the MEM_ defines
+	multiChannel * chans = new multiChannel();
+	this->multiChannels.push_back(chans);
+	chans->add(this->port(args, "start", ok));
+	chans->add(this->port(args, "out", ok));
+	chans->add(this->port(args, "data", ok));
+	chans->add(this->port(args, "setBase", ok));
+	chans->add(this->port(args, "setStride", ok));
+	chans->add(this->port(args, "setEnd", ok));
+	if(!ok){
+	    return false;
+	}
+	MemStream * mem = new MemStream(chans, base, stride, end, write != 0, tag, this->memoryNames[args["memory"]].first);
+	if(this->bankNames.count(args["memory"]) > 0){
+	    mem->setBanks(this->bankNames[args["memory"]]);
+	}
+	if(this->cacheNames.count(args["memory"]) > 0){
+	    mem->setCache(this->cacheNames[args["memory"]]);
+	}
+	// Giving a window or latency lets a reader keep several reads in flight
+	if(args.count("window") > 0 || args.count("latency") > 0){
+	    int window = 1, latency = 1;
+	    if((args.count("window") > 0 && !parseInt(args["window"], window)) ||
+	       (args.count("latency") > 0 && !parseInt(args["latency"], latency))){
+	        delete mem;
+		return this->error("memstream window and latency must be numbers");
+	    }
+	    mem->setWindow(window, latency);
+	}
+	// Nested loops are count:stride pairs, innermost first, like loops=3:1,3:8
+	if(args.count("loops") > 0){
+	    int counts[MAX_MEM_LOOPS], strides[MAX_MEM_LOOPS];
+	    int numLoops = 0;
+	    std::stringstream list(args["loops"]);
+	    std::string loop;
+	    while(std::getline(list, loop, ',')){
+	        size_t split = loop.find(':');
+		if(numLoops == MAX_MEM_LOOPS || split == std::string::npos ||
+		   !parseInt(loop.substr(0, split), counts[numLoops]) || !parseInt(loop.substr(split + 1), strides[numLoops])){
+		    delete mem;
+		    return this->error("memstream loops must be up to 4 count:stride pairs");
+		}
+		numLoops++;
+	    }
+	    // The lowest and highest address the loops reach from base
+	    long long low = base, high = base;
+	    for(int d=0; d < numLoops; d++){
+	        long long extent = (long long)(counts[d] - 1) * strides[d];
+		if(counts[d] < 1){
+		    delete mem;
+		    return this->error("memstream loop counts must be at least 1");
+		}
+		if(extent < 0){
+		    low += extent;
+		}
+		else{
+		    high += extent;
+		}
+	    }
+	    if(low < 0 || high >= memSize){
+	        delete mem;
+		return this->error("memstream loops reach outside its memory");
+	    }
+	    mem->setLoops(numLoops, counts, strides);
+	}
+	this->mems.push_back(mem);
+	this->memNames[name] = mem;
+	this->sim->addMemStream(mem);
+	this->names[MEM_MODULE].push_back(name);
+    }
+    else if(keyword == "multiplier"){
+        if(!this->parseArgs(tokens, args, multArgs, sizeof(multArgs) / sizeof(multArgs[0]))){
+	    return false;
+	}
+	this->applyOverrides(name, args, multArgs, sizeof(multArgs) / sizeof(multArgs[0]));
+	int tag = 0;
+	if(args.count("tag") > 0 && !parseInt(args["tag"], tag)){
+	    return this->error("multiplier tag must be a number");
+	}
+	// Ports go in the order of the M_ defines
+	multiChannel * chans = new multiChannel();
+	this->multiChannels.push_back(chans);
+	chans->add(this->port(args, "out", ok));
+	chans->add(this->port(args, "mult1", ok));
+	chans->add(this->port(args, "mult2", ok));
+	if(!ok){
+	    return false;
+	}
+	Multiplier * mult = new Multiplier(chans, tag);
+	// Giving a latency or interval pipelines the multiplier
+	if(args.count("latency") > 0 || args.count("interval") > 0){
+	    int latency = 1, interval = 1;
+	    if((args.count("latency") > 0 && !parseInt(args["latency"], latency)) ||
+	       (args.count("interval") > 0 && !parseInt(args["interval"], interval))){
+	        delete mult;
+		return this->error("multiplier latency and interval must be numbers");
+	    }
+	    mult->setPipeline(latency, interval);
+	}
+	this->mults.push_back(mult);
+	this->multNames[name] = mult;
+	this->sim->addMultiplier(mult);
+	this->names[MULT_MODULE].push_back(name);
+    }
+    else if(keyword == "mac"){
+        if(!this->parseArgs(tokens, args, macArgs, sizeof(macArgs) / sizeof(macArgs[0]))){
+	    return false;
+	}
+	this->applyOverrides(name, args, macArgs, sizeof(macArgs) / sizeof(macArgs[0]));
+	int tag = 0;
+	if(args.count("tag") > 0 && !parseInt(args["tag"], tag)){
+	    return this->error("mac tag must be a number");
+	}
+	// Ports go in the order of the MAC_ defines
+	multiChannel * chans = new multiChannel();
+	this->multiChannels.push_back(chans);
+	chans->add(this->port(args, "out", ok));
+	chans->add(this->port(args, "mult1", ok));
+	chans->add(this->port(args, "mult2", ok));
+	if(!ok){
+	    return false;
+	}
+	MAC * mac = new MAC(chans, tag);
+	this->macs.push_back(mac);
+	this->macNames[name] = mac;
+	this->sim->addMAC(mac);
+	this->names[MAC_MODULE].push_back(name);
+    }
+    else if(keyword == "tia"){
+        if(!this->parseArgs(tokens, args, tiaArgs, sizeof(tiaArgs) / sizeof(tiaArgs[0]))){
+	    return false;
+	}
+	this->applyOverrides(name, args, tiaArgs, sizeof(tiaArgs) / sizeof(tiaArgs[0]));
+	int preds = 0, regs = 0, width = 1, depth = 1;
+	if((args.count("preds") > 0 && !parseInt(args["preds"], preds)) ||
+	   (args.count("regs") > 0 && !parseInt(args["regs"], regs)) ||
+	   (args.count("width") > 0 && !parseInt(args["width"], width)) ||
+	   (args.count("depth") > 0 && !parseInt(args["depth"], depth))){
+	    return this->error("tia preds, regs, width, and depth must be numbers");
+	}
+	IssuePolicy policy = LOWEST_INDEX;
+	if(args.count("policy") > 0){
+	    if(args["policy"] == "ROUND_ROBIN"){
+	        policy = ROUND_ROBIN;
+	    }
+	    else if(args["policy"] == "OLDEST_READY"){
+	        policy = OLDEST_READY;
+	    }
+	    else if(args["policy"] != "LOWEST_INDEX"){
+	        return this->error(("unknown issue policy " + args["policy"]).c_str());
+	    }
+	}
+	multiChannel * help = new multiChannel();
+	multiChannel * in = new multiChannel();
+	multiChannel * out = new multiChannel();
+	this->multiChannels.push_back(help);
+	this->multiChannels.push_back(in);
+	this->multiChannels.push_back(out);
+	if(!this->portList(args, "help", help) || !this->portList(args, "in", in) || !this->portList(args, "out", out)){
+	    return false;
+	}
+	// The TIA always looks at its T_WRITE helper channel
+	if(help->getNumChannels() == 0){
+	    help->add(this->port(args, "help", ok));
+	}
+	TIA * tia = new TIA(help, in, out, preds, regs, width, policy, depth);
+	this->tias.push_back(tia);
+	this->tiaNames[name] = tia;
+	this->sim->addTIA(tia);
+	this->names[TIA_MODULE].push_back(name);
+
+	// Assemble the TIA's program and put it straight into iMem
+	if(args.count("program") > 0){
+	    TIAprogram program;
+	    if(!program.assemble(args["program"].c_str())){
+	        return this->error(("could not assemble " + args["program"]).c_str());
+	    }
+	    tia->addProgram(program);
+	}
+    }
+    else{
+        return this->error(("unknown keyword " + keyword).c_str());
+    }
+    return true;
+};
+
+// Named channel, or NULL
+liChannel * Netlist::getChannel(const std::string &name){
+    std::map<std::string, liChannel *>::iterator it = this->channelNames.find(name);
+    return it == this->channelNames.end() ? NULL : it->second;
+};
+
+// Named memory, or NULL
+int * Netlist::getMemory(const std::string &name){
+    std::map<std::string, pair<int *, int> >::iterator it = this->memoryNames.find(name);
+    return it == this->memoryNames.end() ? NULL : it->second.first;
+};
+
+// Banks of a named memory, or NULL if it isn't banked
+BankedMemory * Netlist::getBankedMemory(const std::string &name){
+    std::map<std::string, BankedMemory *>::iterator it = this->bankNames.find(name);
+    return it == this->bankNames.end() ? NULL : it->second;
+};
+
+// Cache in front of a named memory, or NULL if it isn't cached
+Cache * Netlist::getCache(const std::string &name){
+    std::map<std::string, Cache *>::iterator it = this->cacheNames.find(name);
+    return it == this->cacheNames.end() ? NULL : it->second;
+};
+
+// Named fifo, or NULL
+Fifo * Netlist::getFifo(const std::string &name){
+    std::map<std::string, Fifo *>::iterator it = this->fifoNames.find(name);
+    return it == this->fifoNames.end() ? NULL : it->second;
+};
+
+// Named memory streamer, or NULL
+MemStream * Netlist::getMemStream(const std::string &name){
+    std::map<std::string, MemStream *>::iterator it = this->memNames.find(name);
+    return it == this->memNames.end() ? NULL : it->second;
+};
+
+// Named multiplier, or NULL
+Multiplier * Netlist::getMultiplier(const std::string &name){
+    std::map<std::string, Multiplier *>::iterator it = this->multNames.find(name);
+    return it == this->multNames.end() ? NULL : it->second;
+};
+
+// Named multiply accumulate, or NULL
+MAC * Netlist::getMAC(const std::string &name){
+    std::map<std::string, MAC *>::iterator it = this->macNames.find(name);
+    return it == this->macNames.end() ? NULL : it->second;
+};
+
+// Named TIA, or NULL
+TIA * Netlist::getTIA(const std::string &name){
+    std::map<std::string, TIA *>::iterator it = this->tiaNames.find(name);
+    return it == this->tiaNames.end() ? NULL : it->second;
+};
+
+#endif
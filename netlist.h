@@ -0,0 +1,141 @@
+///////////////////////////////////
+// Netlist Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for the netlist loader.
+A netlist is a text file that describes the channels, memories,
+and modules of a fabric and how they are wired together, so that
+a new topology doesn't need a new kernel or a recompile.
+Every line is a keyword followed by its arguments, and # starts a comment:
+
+    channel <name> <capacity> [spsc]
+    memory <name> <size> file=<path> private=<0/1> banks=<n> interleave=<n> ports=<n>
+           cache=<words> ways=<n> line=<words> policy=<LRU/FIFO/RANDOM> writeback=<0/1> hit=<n> miss=<n>
+    fill <memory> <addr> <value> <value> ...
+    packet <channel> <data or instruction name> [tag]
+    fifo <name> size=<n> push=<n> pop=<n> out=<chan> data=<chan>
+    memstream <name> memory=<mem> base=<n> stride=<n> end=<n> write=<0/1> tag=<n> window=<n> latency=<n>
+              loops=<count:stride,...>
+              start=<chan> out=<chan> data=<chan> setBase=<chan> setStride=<chan> setEnd=<chan>
+    multiplier <name> tag=<n> latency=<n> interval=<n> out=<chan> mult1=<chan> mult2=<chan>
+    mac <name> tag=<n> out=<chan> mult1=<chan> mult2=<chan>
+    tia <name> preds=<n> regs=<n> width=<n> policy=<LOWEST_INDEX/ROUND_ROBIN/OLDEST_READY> depth=<n>
+        help=<chan,...> in=<chan,...> out=<chan,...> program=<TIA program file>
+    watch <channel>
+
+Ports name the channel that goes in each slot of the module's multiChannel,
+so their order no longer has to match the F_OUT/MEM_START/M_OUT defines by hand.
+A channel marked spsc is lock-free, for channels that cross threads when sim.setThreads is used.
+A fifo given push or pop widths runs in burst mode, and a multiplier
+given a latency or interval is pipelined.  A reading memstream given a
+window or latency keeps up to window reads in flight, and one given
+loops walks those nested loops from base instead of stopping at end.
+A memstream's base, end, and loops must stay inside its memory, and its
+stride must be at least 1.
+A memory given a file is mapped from that file instead of allocated, so
+writes go back to the file unless private=1.  Its size can be 0 to use
+the whole file, and a file that is too short is grown with zeros.
+A netlist set to private memories maps every file privately, so several
+copies of it can run at once without writing over each other's data.
+A memory given banks, interleave, or ports is banked, and every memstream
+on it waits a round for each access ahead of it on a bank with no free port.
+A memory given a cache size has a cache in front of it that its memstreams
+share, and each access takes the hit or miss cycles in place of its Execute
+time.  The cache is write-back unless writeback=0, and defaults to 1 way,
+1 word lines, LRU, 1 cycle hits, and 10 cycle misses.
+A port that isn't given is tied to an unconnected channel.
+Numbers are decimal, even with leading zeros, or hex with a 0x prefix.
+TIA programs use the text syntax described in tiaProgram.h.
+Channels and memories must be declared before they are used.
+No two channels, no two memories, and no two modules can share a name, even modules of different types.
+
+Any number argument can be overridden before load with set, which is
+how a sweep tries many configurations of one netlist.  The key is the
+name of a channel or module and the argument, like f1.size or
+t1.regs, or * in place of the name to change every one of them, like
+*.capacity.  A channel's capacity is set with <name>.capacity.  Load
+fails if an override doesn't match an argument of any line.
+*/
+
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include<vector>
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<stdlib.h>
+#include<stdio.h>
+#include<cstring>
+#include<map>
+#include<set>
+using namespace std;
+
+#include"simulator.cpp"
+
+class Netlist{
+    public:
+	Netlist();                                             // Empty Constructor
+	~Netlist();                                            // Frees every channel, memory, and module the netlist built
+	bool load(const char * fileName, Simulator * sim);     // Builds the fabric in a netlist file and registers it with sim - false on an error or an unused override
+	void set(const std::string &key, const std::string &value); // Overrides an argument before load, like f1.size or *.capacity
+	void setPrivateMemories(bool privateMemories);         // Maps every memory file as if it were private=1 - set before load
+	std::string getName(ModuleType type, int index);       // Name of a module in the order it was registered with the simulator
+	liChannel * getChannel(const std::string &name);       // Named channel, or NULL
+	int * getMemory(const std::string &name);              // Named memory, or NULL
+	BankedMemory * getBankedMemory(const std::string &name); // Banks of a named memory, or NULL if it isn't banked
+	Cache * getCache(const std::string &name);             // Cache in front of a named memory, or NULL if it isn't cached
+	Fifo * getFifo(const std::string &name);               // Named fifo, or NULL
+	MemStream * getMemStream(const std::string &name);     // Named memory streamer, or NULL
+	Multiplier * getMultiplier(const std::string &name);   // Named multiplier, or NULL
+	MAC * getMAC(const std::string &name);                 // Named multiply accumulate, or NULL
+	TIA * getTIA(const std::string &name);                 // Named TIA, or NULL
+	std::vector<pair<std::string, liChannel *> > watched;  // Channels the netlist asked the kernel to print
+
+    private:
+	Netlist(const Netlist &);                              // The netlist owns raw pointers, so it can't be copied
+	Netlist & operator=(const Netlist &);
+
+	Simulator * sim;
+	int lineNum;                                           // Line of the file being parsed - used for errors
+	bool privateMemories;                                  // Are memory files always mapped privately
+	bool error(const char * message);                      // Prints an error for the current line and returns false
+	bool parseLine(const std::string &line);               // Parses one line of the file
+	bool parseArgs(std::stringstream &tokens, std::map<std::string, std::string> &args, const char * allowed[], int numAllowed);
+	liChannel * port(std::map<std::string, std::string> &args, const char * key, bool &ok); // Channel bound to a port, or an unconnected one
+	bool portList(std::map<std::string, std::string> &args, const char * key, multiChannel * chans); // Comma separated list of channels
+	void applyOverrides(const std::string &name, std::map<std::string, std::string> &args, const char * allowed[], int numAllowed);
+
+	std::map<std::string, std::string> overrides;          // Arguments set before load
+	std::set<std::string> usedOverrides;                   // Overrides that some line took - load fails if any other is set
+	std::vector<std::string> names[NUM_MODULE_TYPES];      // Module names in the order they were registered
+	std::set<std::string> moduleNames;                     // Every module name, whatever its type, so stats and overrides name one module
+
+	std::map<std::string, liChannel *> channelNames;
+	std::map<std::string, pair<int *, int> > memoryNames;  // Memory and its size
+	std::map<std::string, BankedMemory *> bankNames;
+	std::map<std::string, Cache *> cacheNames;
+	std::map<std::string, Fifo *> fifoNames;
+	std::map<std::string, MemStream *> memNames;
+	std::map<std::string, Multiplier *> multNames;
+	std::map<std::string, MAC *> macNames;
+	std::map<std::string, TIA *> tiaNames;
+
+	// Everything that the netlist allocated, so the destructor can free it
+	std::vector<liChannel *> channels;
+	std::vector<multiChannel *> multiChannels;
+	std::vector<int *> memories;
+	std::vector<MappedMemory *> mappedMemories;
+	std::vector<BankedMemory *> bankedMemories;
+	std::vector<Cache *> caches;
+	std::vector<Fifo *> fifos;
+	std::vector<MemStream *> mems;
+	std::vector<Multiplier *> mults;
+	std::vector<MAC *> macs;
+	std::vector<TIA *> tias;
+};
+
+#endif
@@ -20,71 +20,12 @@ tasks.
 #include"timingModel.h"
 using namespace std;
 
-// These defines are used to index into the parsed csv file to find cycle times for the different modules.
-
-#define TIA_SCHEDULE_TIME 4
-#define TIA_COMMIT_TIME 6
-#define MULT_SCHEDULE_TIME 40
-#define MULT_COMMIT_TIME 42
-#define MEM_SCHEDULE_TIME 46
-#define MEM_COMMIT_TIME 48
-#define FIFO_SCHEDULE_TIME 61
-#define FIFO_COMMIT_TIME 63
-
 
 int main(){
 
-    // Define ifstream to parse the cycle times csv file	
-    std::ifstream data("cTimes.csv");
-
-    // Seek to the beginning of the csv file and create an internal vector to keep the cycle times
-    data.seekg(0, data.beg);
-    std::vector<int> cTimes, tempCSV;
-
-    // Basic csv processing that stores the values in the cTimes vector
-    std::string line;
-    while(std::getline(data,line)){
-        std::stringstream  lineStream(line);
-	std::string        cell;
-	while(std::getline(lineStream,cell,',')){
-	        tempCSV.push_back(atoi(cell.c_str()));
-        }
-    }
- 
-    for(int w=0; w<tempCSV.size(); w++){
-        //printf("index: %i :: value: %i\n", w, tempCSV[w]);   
-    }
-    cTimes = tempCSV;
-
-    // Maps times for tia Execute into indexes into cTimes - will change if cTimes.csv changes!!
-    std::map<int, int> tiaTimeMap, multTimeMap, memStreamTimeMap, fifoTimeMap;
-    tiaTimeMap[NOP] = 5;
-    tiaTimeMap[PLUSPLUS] = 8;
-    tiaTimeMap[MINUSMINUS] = 11;
-    tiaTimeMap[ADD] = 14;
-    tiaTimeMap[SUBTRACT] = 17;
-    tiaTimeMap[LESS_THAN] = 20;
-    tiaTimeMap[GREATER_THAN] = 23;
-    tiaTimeMap[LESS_THAN_EQUAL] = 26;
-    tiaTimeMap[GREATER_THAN_EQUAL] = 29;
-    tiaTimeMap[PASS_THROUGH] = 32;
-    tiaTimeMap[PASS_THROUGH_2] = 35;
-    tiaTimeMap[DEQ] = 38;
-    tiaTimeMap[SHIFT_RIGHT] = 71;
-    tiaTimeMap[SHIFT_LEFT] = 74;
-
-    multTimeMap[NOP] = 41;
-    multTimeMap[MULTIPLY] = 44;
-
-    memStreamTimeMap[NOP] = 47;
-    memStreamTimeMap[START_STREAM] = 50;
-    memStreamTimeMap[STOP_STREAM] = 53;
-    memStreamTimeMap[STREAM] = 56;
-    memStreamTimeMap[WRITE_MEM] = 59;
-
-    fifoTimeMap[NOP] = 62;
-    fifoTimeMap[PUSH] = 65;
-    fifoTimeMap[POP] = 68;
+    // Create the simulator, which loads the cycle time file and runs the main loop
+    Simulator sim("cycleTimes.cfg");
+    sim.setEventDriven(true);
 
 
 
@@ -1012,67 +953,23 @@ int main(){
 
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Create vectors of all modules so that we can run them in our timing model main loop
+    // Register all modules and channels with the simulator so that it can run them in its main loop
 
+    sim.addTIA(&t1);
+    sim.addTIA(&t2);
 
-    std::vector<MemStream *> mems;
-    std::vector<Multiplier *> mults;
-    std::vector<Fifo *> fifos;
-    std::vector<liChannel *> channels;
-    std::vector<TIA *> tias;
+    sim.addChannel(&in);
+    sim.addChannel(&tOut1);
+    sim.addChannel(&tSumOut1);
+    sim.addChannel(&tCountOut1);
 
-    // Add all modules to the proper vectors
-
-    tias.push_back(&t1);
-    tias.push_back(&t2);
-
-    channels.push_back(&in);
-    channels.push_back(&tOut1);
-    channels.push_back(&tSumOut1);
-    channels.push_back(&tCountOut1);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Define temp variables and totalTime = the system time for the timing model 
-    int totalTime = 0, cycleTime = 0, totalMemTime = 0, totalFifoTime = 0, totalMultTime = 0, totalTIAtime = 0, totalMemOverhead = 0, totalFifoOverhead = 0, totalMultOverhead = 0, totalTIAOverhead = 0;
-   
-    // Add up all the times to find our timing bottleneck to see our total cycle time 
-    totalMemOverhead = cTimes[MEM_SCHEDULE_TIME] + cTimes[MEM_COMMIT_TIME];
-    totalFifoOverhead = cTimes[FIFO_SCHEDULE_TIME] + cTimes[FIFO_COMMIT_TIME];
-    totalMultOverhead = cTimes[MULT_SCHEDULE_TIME] + cTimes[MULT_COMMIT_TIME];
-    totalTIAOverhead = cTimes[TIA_SCHEDULE_TIME] + cTimes[TIA_COMMIT_TIME];
-
-    int maxMemTime = 0, maxFifoTime = 0, maxMultTime = 0, maxTIAtime = 0;
-
-    // Main loop for the timing model - set off all modules in a loop like fashion
-    while(1){
-
-
-	// Correctly set all canPop and canPush variables for all channels based on channel properties and the last cycle
-        for (unsigned i = 0; i < channels.size(); i++){
-	    if(channels[i]->numInFlight() == 0){
-	        channels[i]->setCanPop(false);
-		channels[i]->setCanPush(true);
-	    }
-	    else if(channels[i]->numInFlight() == channels[i]->getMax()){
-	        channels[i]->setCanPop(true);
-		channels[i]->setCanPush(false);
-	    }
-	    else{
-	        channels[i]->setCanPop(true);
-		channels[i]->setCanPush(true);
-	    }
-	}
-	maxMemTime = 0;
-	maxFifoTime = 0;
-	maxMultTime = 0;
-	maxTIAtime = 0;
-
-	Instruction whichMem = NOP, whichFifo = NOP, whichMult = NOP, whichTIA = NOP;
-	int whichIndex = 0;
-
-        // Set off any module that can schedule, execute, and commit
-	
+    // Main loop for the timing model - the simulator sets off all modules in a loop like fashion
+    // until the fabric goes quiescent
+    while(!sim.done()){
+	sim.beginCycle();
 
 	if(tSumOut1.getCanPop()){
 	    printf("Sum: %i\n", tSumOut1.peek().data);
@@ -1080,93 +977,20 @@ int main(){
 	if(tCountOut1.getCanPop()){
 	    printf("Count: %i\n", tCountOut1.peek().data);
 	}
-	
-
-        for (unsigned i = 0; i < mems.size(); i++){
-	    Dynamic_Instruction sResult = mems[i]->schedule();
-	    Dynamic_Instruction eResult = mems[i]->execute(sResult);
-            if(cTimes[memStreamTimeMap[eResult.getInst()]] > maxMemTime){
-	        maxMemTime = cTimes[memStreamTimeMap[eResult.getInst()]];
-		whichMem = eResult.getInst();
-	    }
-	    mems[i]->commit(eResult);
-	}
-
-	for(unsigned i = 0; i < fifos.size(); i++){
-	    Dynamic_Instruction sResult = fifos[i]->schedule();
-	    Dynamic_Instruction eResult = fifos[i]->execute(sResult);
-            if(cTimes[fifoTimeMap[eResult.getInst()]] > maxFifoTime){
-	        maxFifoTime = cTimes[fifoTimeMap[eResult.getInst()]];
-		whichFifo = eResult.getInst();
-	    }
-	    fifos[i]->commit(eResult);
-	}
-
-	for(unsigned i=0; i < mults.size(); i++){
-	    Dynamic_Instruction sResult = mults[i]->schedule();
-            Dynamic_Instruction eResult = mults[i]->execute(sResult);
-            if(cTimes[multTimeMap[eResult.getInst()]] > maxMultTime){
-	        maxMultTime = cTimes[multTimeMap[eResult.getInst()]];
-		whichMult = eResult.getInst();
-	    }
-	    mults[i]->commit(eResult);
-	}
-        for(unsigned i=0; i < tias.size(); i++){
-	    Dynamic_TIAinstruction sResult = tias[i]->schedule();
-            Dynamic_TIAinstruction eResult = tias[i]->execute(sResult);
-	    if(cTimes[tiaTimeMap[eResult.getCmd()]] >= maxTIAtime){
-	        maxTIAtime = cTimes[tiaTimeMap[eResult.getCmd()]];
-		whichTIA = eResult.getCmd();
-		whichIndex = sResult.getIndex();
-	    }
-	    tias[i]->commit(eResult);
-	}
-
 
+	sim.evaluate();
 
         if(tOut1.getCanPop()){
-	        printf("Output: %i\n", tOut1.get().data);
-		printf("Number of Cycles: %i\n", totalTime);
-	}
-
-	totalMemTime = totalMemOverhead + maxMemTime;
-	totalFifoTime = totalFifoOverhead + maxFifoTime;
-	totalMultTime = totalMultOverhead + maxMultTime;
-	totalTIAtime = totalTIAOverhead + maxTIAtime;
-
-	cycleTime = 0;
-	// Calculate total time spent for cycle so that we can keep system time
-        cycleTime = max(totalMemTime, totalFifoTime);
-        cycleTime = max(cycleTime, totalMultTime);
-        cycleTime = max(cycleTime, totalTIAtime);
-
-	if(whichMem != NOP){
-	    //printf("Mem Inst: %i\n", whichMem);
+	    printf("Output: %i\n", tOut1.get().data);
+	    printf("Number of Cycles: %i\n", sim.getTotalTime());
 	}
-	if(whichFifo != NOP){	
-	    //printf("Fifo Inst: %i\n", whichFifo);
-	}
-	if(whichMult != NOP){
-	    //printf("Mult Inst: %i\n", whichMult);
-	}
-	if(whichTIA != NOP){
-	    //printf("TIA Inst: %i\n", whichTIA);
-	    //printf("TIA Index: %i\n", whichIndex);
-	    //printf("Reg0: %i\n", t2.dataRegs.getValue(0));
-	    //printf("Reg1: %i\n", t2.dataRegs.getValue(1));
-	    //printf("Reg2: %i\n", t2.dataRegs.getValue(2));
-	    //printf("Reg3: %i\n", t2.dataRegs.getValue(3));
-	    //printf("Reg4: %i\n", t2.dataRegs.getValue(4));
-	    //printf("Reg5: %i\n", t2.dataRegs.getValue(5));
-	}
-
-
 
 	// Add a cycle's worth of time to the total time
-	totalTime += cycleTime;
-    
+	sim.endCycle();
     }
 
+    sim.report();
+
     return 0;
 }
 
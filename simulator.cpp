@@ -0,0 +1,758 @@
+///////////////////////////////////
+// Simulator
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the simulation engine for the timing model.
+Kernels build their modules and channels, register them
+with the engine, and then call step() to advance the model
+one cycle at a time.  Each cycle updates the channel states,
+runs schedule, execute, and commit on every module, and adds
+the time of the slowest module type to the system time.
+*/
+
+#ifndef SIMULATOR_CPP
+#define SIMULATOR_CPP
+
+#include"simulator.h"
+
+// Number of idle cycles in a row before we decide the fabric is quiescent and stop
+#define DEFAULT_QUIESCENCE_LIMIT 10
+
+
+// Constructor that loads the keyed cycle time file
+Simulator::Simulator(const char * cycleTimeFile){
+    bool loaded = this->times.load(cycleTimeFile);
+    this->init();
+    // Times from a bad file would be wrong or 0, so don't run at all
+    if(!loaded){
+        this->stopReason = BAD_CYCLE_TIMES;
+    }
+};
+
+// Constructor that uses cycle times that were already loaded
+Simulator::Simulator(const CycleTimes &times){
+    this->times = times;
+    this->init();
+};
+
+// Sets up the state shared by both constructors
+void Simulator::init(){
+    this->totalTime = 0;
+    this->cycleTime = 0;
+    this->reconfigTime = 0;
+    this->totalReconfigTime = 0;
+    this->whichMem = NOP;
+    this->whichFifo = NOP;
+    this->whichMult = NOP;
+    this->whichMAC = NOP;
+    this->whichTIA = NOP;
+    this->whichIndex = 0;
+
+    this->numCycles = 0;
+    this->active = false;
+    this->idleCycles = 0;
+    this->idleStartTime = 0;
+    this->quiescenceLimit = DEFAULT_QUIESCENCE_LIMIT;
+    this->maxCycles = 0;       // Unbounded unless the kernel sets a limit
+    this->maxWallClock = 0;    // Unbounded unless the kernel sets a limit
+    this->startWallClock = 0;
+    this->stopReason = RUNNING;
+
+    this->eventDriven = false;  // Run every module every cycle unless the kernel asks otherwise
+    this->wiringChanged = true;
+
+    this->numThreads = 1;
+    this->pool = NULL;
+    this->numPartitions = 0;
+}
+
+// Stops the worker threads
+Simulator::~Simulator(){
+    delete this->pool;
+}
+
+// Number of threads that evaluate modules - 1 runs everything on the calling thread
+// Results are the same for any number of threads
+void Simulator::setThreads(int threads){
+    if(threads < 1){
+        threads = 1;
+    }
+    if(threads == this->numThreads){
+        return;
+    }
+    this->numThreads = threads;
+    delete this->pool;
+    this->pool = NULL;
+    if(threads > 1){
+        this->pool = new ThreadPool(threads);
+    }
+    this->wiringChanged = true;
+}
+
+// Register a channel whose canPush/canPop is updated every cycle
+void Simulator::addChannel(liChannel * chan){
+    this->channels.push_back(chan);
+    this->occupancy.push_back(chan->numInFlight());
+    this->chanFlags.push_back(-1);   // Unknown until the first cycle
+    this->wiringChanged = true;
+}
+
+// Register a memory streamer
+void Simulator::addMemStream(MemStream * mem){
+    this->mems.push_back(mem);
+    this->memAwake.push_back(true);  // Every module runs on its first cycle
+    this->wiringChanged = true;
+}
+
+// Register a fifo
+void Simulator::addFifo(Fifo * fifo){
+    this->fifos.push_back(fifo);
+    this->fifoAwake.push_back(true);
+    this->wiringChanged = true;
+}
+
+// Register a multiplier
+void Simulator::addMultiplier(Multiplier * mult){
+    this->mults.push_back(mult);
+    this->multAwake.push_back(true);
+    this->wiringChanged = true;
+}
+
+// Register a multiply accumulate
+void Simulator::addMAC(MAC * mac){
+    this->macs.push_back(mac);
+    this->macAwake.push_back(true);
+    this->wiringChanged = true;
+}
+
+// Register a TIA
+void Simulator::addTIA(TIA * tia){
+    this->tias.push_back(tia);
+    this->tiaAwake.push_back(true);
+    this->tiaBundles.push_back(std::vector<Dynamic_TIAinstruction>());
+    this->wiringChanged = true;
+}
+
+// Register the banks of a memory so their ports are freed every cycle
+// The memory streamers that use it still have to be given it with setBanks
+void Simulator::addBankedMemory(BankedMemory * banks){
+    this->bankedMemories.push_back(banks);
+}
+
+// Register a cache so report prints it
+// The memory streamers that use it still have to be given it with setCache
+void Simulator::addCache(Cache * cache){
+    this->caches.push_back(cache);
+}
+
+// Only run modules whose channels changed or that were busy last cycle
+// A module that ran a NOP will run a NOP again until one of its channels changes,
+// so skipping it does not change the results of the timing model
+void Simulator::setEventDriven(bool on){
+    this->eventDriven = on;
+}
+
+// Builds wakeLists from the multiChannel wiring
+void Simulator::buildWakeLists(){
+    std::map<liChannel *, int> chanIndex;
+    for (unsigned i = 0; i < channels.size(); i++){
+        chanIndex[channels[i]] = i;
+    }
+
+    this->wakeLists.assign(channels.size(), std::vector<pair<ModuleType, int> >());
+    for (unsigned i = 0; i < mems.size(); i++){
+        this->addWakeups(mems[i]->c, MEM_MODULE, i, chanIndex);
+    }
+    for (unsigned i = 0; i < fifos.size(); i++){
+        this->addWakeups(fifos[i]->getChannels(), FIFO_MODULE, i, chanIndex);
+    }
+    for (unsigned i = 0; i < mults.size(); i++){
+        this->addWakeups(mults[i]->getChannels(), MULT_MODULE, i, chanIndex);
+    }
+    for (unsigned i = 0; i < macs.size(); i++){
+        this->addWakeups(macs[i]->getChannels(), MAC_MODULE, i, chanIndex);
+    }
+    for (unsigned i = 0; i < tias.size(); i++){
+        this->addWakeups(tias[i]->helpChans, TIA_MODULE, i, chanIndex);
+        this->addWakeups(tias[i]->inputChans, TIA_MODULE, i, chanIndex);
+        this->addWakeups(tias[i]->outputChans, TIA_MODULE, i, chanIndex);
+    }
+    this->buildPartitions();
+    this->wiringChanged = false;
+}
+
+// Splits the modules into work items and finds every channel that has to be staged
+void Simulator::buildPartitions(){
+    std::map<liChannel *, int> seen;
+    this->wiredChannels.clear();
+    for (unsigned i = 0; i < channels.size(); i++){
+        if(seen.find(channels[i]) == seen.end()){
+	    seen[channels[i]] = i;
+	    this->wiredChannels.push_back(channels[i]);
+	}
+    }
+
+    this->workItems.clear();
+    if(mems.size() > 0){
+        this->workItems.push_back(make_pair(MEM_MODULE, -1));
+    }
+    for (unsigned i = 0; i < mems.size(); i++){
+        this->addWired(mems[i]->c, seen);
+    }
+    for (unsigned i = 0; i < fifos.size(); i++){
+        this->workItems.push_back(make_pair(FIFO_MODULE, (int)i));
+	this->addWired(fifos[i]->getChannels(), seen);
+    }
+    for (unsigned i = 0; i < mults.size(); i++){
+        this->workItems.push_back(make_pair(MULT_MODULE, (int)i));
+	this->addWired(mults[i]->getChannels(), seen);
+    }
+    for (unsigned i = 0; i < macs.size(); i++){
+        this->workItems.push_back(make_pair(MAC_MODULE, (int)i));
+	this->addWired(macs[i]->getChannels(), seen);
+    }
+    for (unsigned i = 0; i < tias.size(); i++){
+        this->workItems.push_back(make_pair(TIA_MODULE, (int)i));
+	this->addWired(tias[i]->helpChans, seen);
+	this->addWired(tias[i]->inputChans, seen);
+	this->addWired(tias[i]->outputChans, seen);
+    }
+
+    this->memResults.resize(mems.size());
+    this->fifoResults.resize(fifos.size());
+    this->multResults.resize(mults.size());
+    this->macResults.resize(macs.size());
+    this->tiaResults.resize(tias.size());
+    this->numPartitions = min(this->numThreads, (int)this->workItems.size());
+
+    // Modules added after the first cycle start their totals at 0
+    ModuleStats empty = {0, 0, 0, 0, 0, 0, 0, 0};
+    this->stats[MEM_MODULE].resize(mems.size(), empty);
+    this->stats[FIFO_MODULE].resize(fifos.size(), empty);
+    this->stats[MULT_MODULE].resize(mults.size(), empty);
+    this->stats[MAC_MODULE].resize(macs.size(), empty);
+    this->stats[TIA_MODULE].resize(tias.size(), empty);
+}
+
+// Adds the channels of a multiChannel to wiredChannels if we haven't seen them yet
+void Simulator::addWired(multiChannel * chans, std::map<liChannel *, int> &seen){
+    for (int i = 0; i < chans->getNumChannels(); i++){
+        if(seen.find(chans->channels[i]) == seen.end()){
+	    seen[chans->channels[i]] = this->wiredChannels.size();
+	    this->wiredChannels.push_back(chans->channels[i]);
+	}
+    }
+}
+
+// Adds a module to the wakeLists of every registered channel in its multiChannel
+void Simulator::addWakeups(multiChannel * chans, ModuleType type, int index, std::map<liChannel *, int> &chanIndex){
+    for (int i = 0; i < chans->getNumChannels(); i++){
+        std::map<liChannel *, int>::iterator found = chanIndex.find(chans->channels[i]);
+	if(found != chanIndex.end()){
+	    this->wakeLists[found->second].push_back(make_pair(type, index));
+	}
+    }
+}
+
+// Wake every module wired to a channel
+void Simulator::wake(int chan){
+    std::vector<pair<ModuleType, int> > &list = this->wakeLists[chan];
+    for (unsigned i = 0; i < list.size(); i++){
+        switch(list[i].first){
+	    case MEM_MODULE:
+	        this->memAwake[list[i].second] = true;
+		break;
+	    case FIFO_MODULE:
+	        this->fifoAwake[list[i].second] = true;
+		break;
+	    case MULT_MODULE:
+	        this->multAwake[list[i].second] = true;
+		break;
+	    case MAC_MODULE:
+	        this->macAwake[list[i].second] = true;
+		break;
+	    case TIA_MODULE:
+	        this->tiaAwake[list[i].second] = true;
+		break;
+	}
+    }
+}
+
+// Correctly set all canPop and canPush variables for all channels based on channel properties and the last cycle
+void Simulator::beginCycle(){
+    if(this->numCycles == 0){
+        this->startWallClock = time(NULL);
+    }
+    if(this->wiringChanged){
+        this->buildWakeLists();
+    }
+    for (unsigned i = 0; i < channels.size(); i++){
+        int inFlight = channels[i]->numInFlight();
+	bool canPop = inFlight != 0;
+	bool canPush = inFlight != channels[i]->getMax();
+	this->occupancy[i] = inFlight;   // Remember occupancy so that endCycle can see if anything moved
+	channels[i]->setCanPop(canPop);
+	channels[i]->setCanPush(canPush);
+	channels[i]->setOccupancy(inFlight);
+
+	// If the channel looks different to its modules than it did last cycle, wake them up
+	char flags = (canPop ? 1 : 0) | (canPush ? 2 : 0);
+	if(flags != this->chanFlags[i] && this->eventDriven){
+	    this->wake(i);
+	}
+	this->chanFlags[i] = flags;
+    }
+}
+
+// Set off any module that can schedule, execute, and commit, and find the length of the cycle
+void Simulator::evaluate(){
+    // Every module type pays its schedule and commit time, even if it has no modules
+    int maxMemTime = times.overhead(MEM_MODULE), maxFifoTime = times.overhead(FIFO_MODULE);
+    int maxMultTime = times.overhead(MULT_MODULE), maxTIAtime = times.overhead(TIA_MODULE);
+    int maxMACtime = times.overhead(MAC_MODULE);
+    int maxComputeTime = 0;
+    int maxTIAcomputeTime = maxTIAtime;  // TIA time without reconfiguration, so we can tell how much reconfiguring cost
+
+    this->whichMem = NOP;
+    this->whichFifo = NOP;
+    this->whichMult = NOP;
+    this->whichMAC = NOP;
+    this->whichTIA = NOP;
+    this->whichIndex = 0;
+    this->active = false;
+
+    if(this->wiringChanged){
+        this->buildWakeLists();
+    }
+
+    // Hold every put until all modules have run, so every module sees the channels as they were at the start of the cycle
+    for (unsigned i = 0; i < wiredChannels.size(); i++){
+        wiredChannels[i]->stage(true);
+    }
+    if(this->pool != NULL && this->numPartitions > 1){
+        this->pool->run(Simulator::runPartitionTask, this, this->numPartitions);
+    }
+    else{
+        for (int p = 0; p < this->numPartitions; p++){
+	    this->runPartition(p);
+	}
+    }
+    for (unsigned i = 0; i < wiredChannels.size(); i++){
+        wiredChannels[i]->flush();
+	wiredChannels[i]->stage(false);
+    }
+
+    // Fold the results in module order so ties pick the same module no matter which thread ran it
+    this->reduce(MEM_MODULE, memResults, memAwake, maxMemTime, maxComputeTime, this->whichMem, NULL);
+    this->reduce(FIFO_MODULE, fifoResults, fifoAwake, maxFifoTime, maxComputeTime, this->whichFifo, NULL);
+    this->reduce(MULT_MODULE, multResults, multAwake, maxMultTime, maxComputeTime, this->whichMult, NULL);
+    this->reduce(MAC_MODULE, macResults, macAwake, maxMACtime, maxComputeTime, this->whichMAC, NULL);
+    this->reduce(TIA_MODULE, tiaResults, tiaAwake, maxTIAtime, maxTIAcomputeTime, this->whichTIA, &this->whichIndex);
+
+    // Calculate total time spent for cycle so that we can keep system time
+    this->cycleTime = max(maxMemTime, maxFifoTime);
+    this->cycleTime = max(this->cycleTime, maxMultTime);
+    this->cycleTime = max(this->cycleTime, maxMACtime);
+    this->reconfigTime = this->cycleTime;
+    this->cycleTime = max(this->cycleTime, maxTIAtime);
+
+    // Whatever reconfiguring added on top of the slowest compute is reconfiguration overhead
+    this->reconfigTime = this->cycleTime - max(this->reconfigTime, maxTIAcomputeTime);
+}
+
+// Folds the results of one module type in module order
+void Simulator::reduce(ModuleType type, std::vector<ModuleResult> &results, std::vector<char> &awake,
+                       int &maxTime, int &maxComputeTime, Instruction &which, int * index){
+    // Modules that are asleep are running a NOP, so we charge them the NOP time
+    bool skipped = false;
+    for (unsigned i = 0; i < results.size(); i++){
+        if(!results[i].ran){
+	    skipped = true;
+	    continue;
+	}
+	if(results[i].time > maxTime){
+	    maxTime = results[i].time;
+	    which = results[i].inst;
+	    if(index != NULL){
+	        *index = results[i].index;
+	    }
+	}
+	if(results[i].computeTime > maxComputeTime){
+	    maxComputeTime = results[i].computeTime;
+	}
+	this->active = this->active || awake[i];
+
+	ModuleStats &total = this->stats[type][i];
+	total.cycles++;
+	total.busy += results[i].inst != NOP ? 1 : 0;
+	total.time += results[i].time;
+    }
+    if(skipped && times.total(type, NOP) > maxTime){
+        maxTime = times.total(type, NOP);
+	which = NOP;
+	if(index != NULL){
+	    *index = -1;
+	}
+    }
+    if(skipped && times.total(type, NOP) > maxComputeTime){
+        maxComputeTime = times.total(type, NOP);
+    }
+}
+
+// Runs every work item in a partition - partitions are contiguous so each thread walks its own slice
+void Simulator::runPartition(int partition){
+    int numItems = this->workItems.size();
+    int begin = (long long)partition * numItems / this->numPartitions;
+    int end = (long long)(partition + 1) * numItems / this->numPartitions;
+    for (int w = begin; w < end; w++){
+        switch(this->workItems[w].first){
+	    case MEM_MODULE:
+	        this->runMems();
+		break;
+	    case FIFO_MODULE:
+	        this->runFifo(this->workItems[w].second);
+		break;
+	    case MULT_MODULE:
+	        this->runMult(this->workItems[w].second);
+		break;
+	    case MAC_MODULE:
+	        this->runMAC(this->workItems[w].second);
+		break;
+	    case TIA_MODULE:
+	        this->runTIA(this->workItems[w].second);
+		break;
+	}
+    }
+}
+
+// Entry point for the thread pool
+void Simulator::runPartitionTask(void * sim, int partition){
+    static_cast<Simulator *>(sim)->runPartition(partition);
+}
+
+// Runs every memory streamer in order - they share main memory, so they can't be split across threads
+void Simulator::runMems(){
+    for (unsigned b = 0; b < bankedMemories.size(); b++){
+        bankedMemories[b]->beginCycle();
+    }
+    for (unsigned i = 0; i < mems.size(); i++){
+        ModuleResult &result = this->memResults[i];
+	result.ran = false;
+        if(this->eventDriven && !this->memAwake[i]){
+	    continue;
+	}
+        Dynamic_Instruction sResult = mems[i]->schedule();
+	Dynamic_Instruction eResult = mems[i]->execute(sResult);
+	result.ran = true;
+	result.inst = eResult.getInst();
+	result.time = times.total(MEM_MODULE, result.inst);
+	int access = times.get(MEM_MODULE, EXECUTE_PHASE, result.inst);
+	// A cached access takes the cache's hit or miss latency in place of its Execute time
+	if(mems[i]->cacheTime >= 0){
+	    result.time += mems[i]->cacheTime - access;
+	}
+	// Every round spent waiting for a bank port is another execute of the access
+	result.time += mems[i]->bankWait * access;
+	result.computeTime = result.time;
+	result.index = -1;
+	this->memAwake[i] = eResult.getInst() != NOP;
+	// A windowed streamer stays awake until the cycle after its last read comes back
+	if(mems[i]->isBusy()){
+	    this->memAwake[i] = true;
+	}
+	mems[i]->commit(eResult);
+	if(mems[i]->isBusy()){
+	    this->memAwake[i] = true;
+	}
+    }
+}
+
+// Runs one fifo
+void Simulator::runFifo(int i){
+    ModuleResult &result = this->fifoResults[i];
+    result.ran = false;
+    if(this->eventDriven && !this->fifoAwake[i]){
+        return;
+    }
+    Dynamic_Instruction sResult = fifos[i]->schedule();
+    Dynamic_Instruction eResult = fifos[i]->execute(sResult);
+    result.ran = true;
+    result.inst = eResult.getInst();
+    result.time = times.total(FIFO_MODULE, result.inst);
+    result.computeTime = result.time;
+    result.index = -1;
+    this->fifoAwake[i] = eResult.getInst() != NOP;
+    fifos[i]->commit(eResult);
+}
+
+// Runs one multiplier
+void Simulator::runMult(int i){
+    ModuleResult &result = this->multResults[i];
+    result.ran = false;
+    if(this->eventDriven && !this->multAwake[i]){
+        return;
+    }
+    Dynamic_Instruction sResult = mults[i]->schedule();
+    Dynamic_Instruction eResult = mults[i]->execute(sResult);
+    result.ran = true;
+    result.inst = eResult.getInst();
+    result.time = times.total(MULT_MODULE, result.inst);
+    result.computeTime = result.time;
+    result.index = -1;
+    this->multAwake[i] = eResult.getInst() != NOP;
+    // A pipelined multiplier stays awake until the cycle after its pipeline empties and its interval runs out
+    if(mults[i]->isBusy()){
+        this->multAwake[i] = true;
+    }
+    mults[i]->commit(eResult);
+    if(mults[i]->isBusy()){
+        this->multAwake[i] = true;
+    }
+}
+
+// Runs one multiply accumulate
+void Simulator::runMAC(int i){
+    ModuleResult &result = this->macResults[i];
+    result.ran = false;
+    if(this->eventDriven && !this->macAwake[i]){
+        return;
+    }
+    Dynamic_Instruction sResult = macs[i]->schedule();
+    Dynamic_Instruction eResult = macs[i]->execute(sResult);
+    result.ran = true;
+    result.inst = eResult.getInst();
+    result.time = times.total(MAC_MODULE, result.inst);
+    result.computeTime = result.time;
+    result.index = -1;
+    this->macAwake[i] = eResult.getInst() != NOP;
+    macs[i]->commit(eResult);
+}
+
+// Runs one TIA
+void Simulator::runTIA(int i){
+    ModuleResult &result = this->tiaResults[i];
+    result.ran = false;
+    if(this->eventDriven && !this->tiaAwake[i]){
+        return;
+    }
+    result.ran = true;
+    result.time = -1;
+    result.computeTime = -1;
+    result.inst = NOP;
+    result.index = -1;
+
+    // A TIA can issue several instructions in a cycle - they all execute before any of them commit
+    std::vector<Dynamic_TIAinstruction> &bundle = this->tiaBundles[i];
+    tias[i]->schedule(bundle);
+    // A TIA that is loading a program reads a word every cycle, even though its channel flags don't change
+    this->tiaAwake[i] = tias[i]->isLoading() || tias[i]->getWordsLoaded() > 0;
+    // Reading program words and swapping programs happen on top of whatever the TIA runs this cycle
+    int reconfig = times.reconfigure(TIA_MODULE, tias[i]->getWordsLoaded(), tias[i]->getSwapped());
+    for(unsigned b=0; b < bundle.size(); b++){
+        Dynamic_TIAinstruction &eResult = bundle[b];
+	eResult = tias[i]->execute(eResult);
+	if(times.total(TIA_MODULE, eResult.getCmd()) + reconfig > result.time){
+	    result.time = times.total(TIA_MODULE, eResult.getCmd()) + reconfig;
+	    result.inst = eResult.getCmd();
+	    result.index = eResult.getIndex();
+	}
+	if(times.total(TIA_MODULE, eResult.getCmd()) > result.computeTime){
+	    result.computeTime = times.total(TIA_MODULE, eResult.getCmd());
+	}
+	if(eResult.getIndex() != -1){
+	    this->tiaAwake[i] = true;
+	}
+    }
+    // Commits whatever has finished - a pipelined TIA stays awake until the cycle after its last commit
+    if(tias[i]->getNumInFlight() > 0){
+        this->tiaAwake[i] = true;
+    }
+    tias[i]->advance(bundle);
+    if(tias[i]->getNumInFlight() > 0){
+        this->tiaAwake[i] = true;
+    }
+}
+
+// Add a cycle's worth of time to the total time and check if we should stop
+void Simulator::endCycle(){
+    this->totalTime += this->cycleTime;
+    this->totalReconfigTime += this->reconfigTime;
+    this->numCycles++;
+
+    // A cycle is idle if every module ran a NOP and no channel changed occupancy
+    for (unsigned i = 0; i < channels.size() && !this->active; i++){
+        if(channels[i]->numInFlight() != this->occupancy[i]){
+	    this->active = true;
+	}
+    }
+
+    if(this->active){
+        this->idleCycles = 0;
+    }
+    else{
+        if(this->idleCycles == 0){
+	    this->idleStartTime = this->totalTime - this->cycleTime;
+	}
+	this->idleCycles++;
+    }
+
+    if(this->quiescenceLimit > 0 && this->idleCycles >= this->quiescenceLimit){
+        // The idle cycles are not part of the kernel, so the final time is when the fabric went idle
+        this->totalTime = this->idleStartTime;
+	this->stopReason = QUIESCENT;
+    }
+    else if(this->maxCycles > 0 && this->numCycles >= this->maxCycles){
+        this->stopReason = MAX_CYCLES;
+    }
+    else if(this->maxWallClock > 0 && difftime(time(NULL), this->startWallClock) >= this->maxWallClock){
+        this->stopReason = MAX_WALLCLOCK;
+    }
+}
+
+// Run one full cycle of the timing model
+void Simulator::step(){
+    this->beginCycle();
+    this->evaluate();
+    this->endCycle();
+}
+
+// Step until the simulator is done and return the total time
+int Simulator::run(){
+    while(!this->done()){
+        this->step();
+    }
+    return this->totalTime;
+}
+
+// Checks if the simulator has stopped
+bool Simulator::done(){
+    return this->stopReason != RUNNING;
+}
+
+// Prints why the simulator stopped and the final time
+void Simulator::report(){
+    switch(this->stopReason){
+        case RUNNING:
+	    printf("Simulation still running\n");
+	    break;
+	case QUIESCENT:
+	    printf("Simulation quiescent after %i idle cycles\n", this->idleCycles);
+	    break;
+	case MAX_CYCLES:
+	    printf("Simulation hit the limit of %i cycles\n", this->maxCycles);
+	    break;
+	case MAX_WALLCLOCK:
+	    printf("Simulation hit the limit of %i seconds\n", this->maxWallClock);
+	    break;
+	case BAD_CYCLE_TIMES:
+	    printf("Simulation didn't run because the cycle time file couldn't be loaded\n");
+	    break;
+    }
+    printf("Total Cycles Run: %i\n", this->numCycles);
+    printf("Total Time: %i\n", this->totalTime);
+    if(this->totalReconfigTime > 0){
+        printf("Reconfiguration Time: %i\n", this->totalReconfigTime);
+    }
+    for (unsigned b = 0; b < bankedMemories.size(); b++){
+        printf("Banked Memory %i:\n", b);
+	bankedMemories[b]->report();
+    }
+    for (unsigned c = 0; c < caches.size(); c++){
+        printf("Cache %i: %lli hits, %lli misses, %lli evictions, %lli write backs\n", c, caches[c]->getHits(),
+	       caches[c]->getMisses(), caches[c]->getEvictions(), caches[c]->getWriteBacks());
+    }
+    for (unsigned i = 0; i < mems.size(); i++){
+        if(mems[i]->cache != NULL){
+	    printf("MemStream %i Cache: %i hits, %i misses, %i evictions\n", i, mems[i]->cacheHits, mems[i]->cacheMisses, mems[i]->cacheEvictions);
+	}
+    }
+}
+
+// Number of idle cycles in a row before we stop - 0 never stops
+void Simulator::setQuiescenceLimit(int cycles){
+    this->quiescenceLimit = cycles;
+}
+
+// Maximum number of cycles to run - 0 is unbounded
+void Simulator::setMaxCycles(int cycles){
+    this->maxCycles = cycles;
+}
+
+// Maximum number of real seconds to run - 0 is unbounded
+void Simulator::setMaxWallClock(int seconds){
+    this->maxWallClock = seconds;
+}
+
+// Returns the system time of the timing model
+int Simulator::getTotalTime(){
+    return this->totalTime;
+}
+
+// Returns the length of the last evaluated cycle
+int Simulator::getCycleTime(){
+    return this->cycleTime;
+}
+
+// Returns the number of cycles that have been run
+int Simulator::getNumCycles(){
+    return this->numCycles;
+}
+
+// Returns why the simulator stopped, or RUNNING
+StopReason Simulator::getStopReason(){
+    return this->stopReason;
+}
+
+// Returns how much of the total time went to reconfiguring TIAs
+int Simulator::getReconfigTime(){
+    return this->totalReconfigTime;
+}
+
+// Returns the cycle time table so times can be changed between runs
+CycleTimes & Simulator::getCycleTimes(){
+    return this->times;
+}
+
+// Number of registered modules of a type
+int Simulator::getNumModules(ModuleType type){
+    switch(type){
+        case MEM_MODULE:
+	    return this->mems.size();
+	case FIFO_MODULE:
+	    return this->fifos.size();
+	case MULT_MODULE:
+	    return this->mults.size();
+	case MAC_MODULE:
+	    return this->macs.size();
+	case TIA_MODULE:
+	    return this->tias.size();
+    }
+    return 0;
+}
+
+// What one module did so far, in the order modules were added
+ModuleStats Simulator::getStats(ModuleType type, int index){
+    if(index < 0 || index >= (int)this->stats[type].size()){
+        ModuleStats empty = {0, 0, 0, 0, 0, 0, 0, 0};
+	return empty;
+    }
+    ModuleStats result = this->stats[type][index];
+    if(type == FIFO_MODULE){
+        result.highWater = this->fifos[index]->getHighWater();
+    }
+    if(type == MULT_MODULE){
+        result.stalls = this->mults[index]->getStalls();
+    }
+    if(type == MEM_MODULE){
+        result.highWater = this->mems[index]->maxOutstanding;
+	result.stalls = this->mems[index]->stalls + this->mems[index]->bankStalls;
+	result.hits = this->mems[index]->cacheHits;
+	result.misses = this->mems[index]->cacheMisses;
+	result.evictions = this->mems[index]->cacheEvictions;
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,177 @@
+///////////////////////////////////
+// Simulator Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for the simulation engine.
+The engine owns the modules and channels of a timing model,
+the parsed cycle times, and the main update loop that every
+kernel used to copy into its own main function.
+*/
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include<vector>
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<stdlib.h>
+#include<stdio.h>
+#include<time.h>
+#include<map>
+using namespace std;
+
+#include"liChannel.cpp"
+#include"spscChannel.cpp"
+#include"multiplier.cpp"
+#include"mac.cpp"
+#include"memStream.cpp"
+#include"fifo.cpp"
+#include"multiChannel.cpp"
+#include"tia.cpp"
+#include"cycleTimes.cpp"
+#include"threadPool.cpp"
+#include"mappedMemory.cpp"
+#include"bankedMemory.cpp"
+#include"cache.cpp"
+
+// Reasons that the simulator can stop running
+enum StopReason{
+    RUNNING = 0,
+    QUIESCENT = 1,
+    MAX_CYCLES = 2,
+    MAX_WALLCLOCK = 3,
+    BAD_CYCLE_TIMES = 4   // The cycle time file couldn't be loaded, so nothing was run
+};
+
+// What one module did on a cycle - filled in by whichever thread ran the module
+struct ModuleResult{
+    bool ran;            // False if the module was asleep
+    int time;            // Cycles of its slowest instruction, with reconfiguration
+    int computeTime;     // Cycles of its slowest instruction, without reconfiguration
+    Instruction inst;    // Instruction that took time cycles
+    int index;           // TIA iMem index of that instruction - -1 for other modules
+};
+
+// What one module did over the whole run
+struct ModuleStats{
+    int cycles;          // Cycles the module was awake and ran
+    int busy;            // Cycles it ran something other than a NOP
+    long long time;      // Cycles of the timing model charged to it, added up
+    int highWater;       // Most packets a fifo held at once, or most reads a streamer had in flight - 0 for other modules
+    int stalls;          // Cycles a pipelined multiplier or windowed streamer was stalled, plus rounds a streamer waited for a bank - 0 for other modules
+    int hits;            // Cache hits, misses, and evictions of a streamer's accesses - 0 for other modules
+    int misses;
+    int evictions;
+};
+
+class Simulator{
+    public:
+	Simulator(const char * cycleTimeFile);   // Constructor that loads the keyed cycle time file
+	Simulator(const CycleTimes &times);      // Constructor that uses cycle times that were already loaded
+	~Simulator();                            // Stops the worker threads
+	void addChannel(liChannel * chan);       // Register a channel whose canPush/canPop is updated every cycle
+	void addMemStream(MemStream * mem);      // Register a memory streamer
+	void addFifo(Fifo * fifo);               // Register a fifo
+	void addMultiplier(Multiplier * mult);   // Register a multiplier
+	void addMAC(MAC * mac);                  // Register a multiply accumulate
+	void addTIA(TIA * tia);                  // Register a TIA
+	void addBankedMemory(BankedMemory * banks); // Register the banks of a memory so their ports are freed every cycle
+	void addCache(Cache * cache);            // Register a cache so report prints it
+	void beginCycle();                       // Update all registered channels from their occupancy
+	void evaluate();                         // Schedule, execute and commit every module and find the cycle time
+	void endCycle();                         // Add the cycle time to the total time
+	void step();                             // Run one full cycle of the timing model
+	int run();                               // Step until the simulator is done and return the total time
+	bool done();                             // Checks if the simulator has stopped
+	void report();                           // Prints why the simulator stopped and the final time
+	void setQuiescenceLimit(int cycles);     // Number of idle cycles in a row before we stop - 0 never stops
+	void setMaxCycles(int cycles);           // Maximum number of cycles to run - 0 is unbounded
+	void setMaxWallClock(int seconds);       // Maximum number of real seconds to run - 0 is unbounded
+	void setEventDriven(bool on);            // Only run modules whose channels changed or that were busy last cycle
+	void setThreads(int threads);            // Number of threads that evaluate modules - 1 runs everything on the calling thread
+	int getTotalTime();                      // Returns the system time of the timing model
+	int getCycleTime();                      // Returns the length of the last evaluated cycle
+	int getNumCycles();                      // Returns the number of cycles that have been run
+	StopReason getStopReason();              // Returns why the simulator stopped, or RUNNING
+	int getReconfigTime();                   // Returns how much of the total time went to reconfiguring TIAs
+	CycleTimes & getCycleTimes();            // Returns the cycle time table so times can be changed between runs
+	int getNumModules(ModuleType type);      // Number of registered modules of a type
+	ModuleStats getStats(ModuleType type, int index); // What one module did so far, in the order modules were added
+
+	// Limiting instruction of each module type on the last evaluated cycle - useful for debugging
+	Instruction whichMem;
+	Instruction whichFifo;
+	Instruction whichMult;
+	Instruction whichMAC;
+	Instruction whichTIA;
+	int whichIndex;
+
+    private:
+	CycleTimes times;                                     // Cycles for every module type, phase, and instruction
+	void init();                                          // Sets up the state shared by both constructors
+	int totalTime;                                        // System time for the timing model
+	int cycleTime;                                        // Length of the last evaluated cycle
+	int numCycles;                                        // Number of cycles that have been run
+	int reconfigTime;                                     // Part of the last cycle that was spent reconfiguring
+	int totalReconfigTime;                                // Part of the total time that was spent reconfiguring
+
+	// Quiescence detection and run limits
+	bool active;                                          // Did any module schedule a non-NOP this cycle
+	std::vector<int> occupancy;                           // Occupancy of each channel at the start of this cycle
+	int idleCycles;                                       // Number of idle cycles in a row
+	int idleStartTime;                                    // System time when the current idle run began
+	int quiescenceLimit;
+	int maxCycles;
+	int maxWallClock;
+	time_t startWallClock;                                // Real time when the first cycle began
+	StopReason stopReason;
+
+	// Event driven scheduling
+	bool eventDriven;
+	bool wiringChanged;                                   // Set when a module or channel is added so we rebuild wakeLists
+	std::vector<std::vector<pair<ModuleType, int> > > wakeLists; // Modules wired to each registered channel
+	std::vector<char> chanFlags;                          // canPop and canPush of each channel on the last cycle
+	std::vector<char> memAwake, fifoAwake, multAwake, macAwake, tiaAwake; // Which modules need to run this cycle - char so threads can write neighbours
+	void buildWakeLists();                                // Builds wakeLists from the multiChannel wiring
+	void addWakeups(multiChannel * chans, ModuleType type, int index, std::map<liChannel *, int> &chanIndex);
+	void wake(int chan);                                  // Wake every module wired to a channel
+
+	std::vector<MemStream *> mems;
+	std::vector<Multiplier *> mults;
+	std::vector<MAC *> macs;
+	std::vector<Fifo *> fifos;
+	std::vector<liChannel *> channels;
+	std::vector<TIA *> tias;
+	std::vector<BankedMemory *> bankedMemories;
+	std::vector<Cache *> caches;
+	std::vector<std::vector<Dynamic_TIAinstruction> > tiaBundles; // Instructions each TIA issued this cycle - reused so we don't allocate
+
+	// Parallel evaluation
+	// Every module is run against the channels as they were at the start of the cycle and its puts are
+	// staged, so the order that modules run in doesn't matter.  Each channel must have a single producer
+	// and a single consumer, which is already true of every kernel since packets would otherwise interleave.
+	int numThreads;
+	ThreadPool * pool;
+	std::vector<liChannel *> wiredChannels;               // Every channel a module touches, registered or not
+	std::vector<pair<ModuleType, int> > workItems;        // Units of work - all memory streamers are one item since they share memory
+	int numPartitions;                                    // Work items are split into this many contiguous partitions
+	std::vector<ModuleResult> memResults, fifoResults, multResults, macResults, tiaResults;
+	std::vector<ModuleStats> stats[NUM_MODULE_TYPES];    // Run totals for every module
+	void buildPartitions();                               // Splits the modules into work items
+	void addWired(multiChannel * chans, std::map<liChannel *, int> &seen);
+	void runPartition(int partition);                     // Runs every work item in a partition
+	static void runPartitionTask(void * sim, int partition);
+	void runMems();                                       // Runs every memory streamer in order
+	void runFifo(int i);
+	void runMult(int i);
+	void runMAC(int i);
+	void runTIA(int i);
+	void reduce(ModuleType type, std::vector<ModuleResult> &results, std::vector<char> &awake,
+	            int &maxTime, int &maxComputeTime, Instruction &which, int * index); // Folds results in module order
+};
+
+#endif
@@ -36,7 +36,7 @@ Dynamic_Instruction Skeleton::schedule(){
 
 // Execute a dynamic_instruction
 Dynamic_Instruction Skeleton::execute(Dynamic_Instruction instruction){
-    // Write any intermediate result to the uncommitted result vector in the Dynamic_instruction and then return it
+    // Write any intermediate result to the Dynamic_instruction with addResult and then return it
     return instruction;
 };
 
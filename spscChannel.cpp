@@ -0,0 +1,97 @@
+///////////////////////////////////
+// Lock-Free Single Producer Single Consumer Channel
+// Date   - 10/18/26
+//////////////////////////////////
+
+
+/*
+This is the lock-free version of the latency insensitive channel,
+for channels whose producer and consumer run on different threads.
+head and tail count every packet ever gotten and put, so the number
+in flight is tail - head even after they wrap around.
+The ring buffer is twice the channel capacity so that a producer that
+puts on the same cycle the channel fills up rarely has to hold a packet back.
+*/
+
+
+#ifndef SPSCCHANNEL_CPP
+#define SPSCCHANNEL_CPP
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+#include "spscChannel.h"
+
+// Constructor that takes the maximum packets in flight for this channel
+spscChannel::spscChannel(int maxInFlight) : liChannel(maxInFlight){
+    int size = 1;
+    while(size < 2 * maxInFlight){
+        size = size << 1;
+    }
+    this->messages.resize(size);
+    this->mask = size - 1;
+    this->head.store(0);
+    this->tail.store(0);
+    this->visibleTail = 0;
+    this->staged = false;
+};
+
+// Peeks at a packet in the channel - consumer only
+packet spscChannel::peek(){
+    return this->messages[this->head.load(std::memory_order_relaxed) & this->mask];
+}
+
+// Gets a packet from the channel - consumer only
+packet spscChannel::get(){
+    unsigned h = this->head.load(std::memory_order_relaxed);
+    packet value = this->messages[h & this->mask];
+    this->head.store(h + 1, std::memory_order_release); // The producer can reuse the slot once it sees the new head
+    return value;
+};
+
+// Gets number of messages in flight
+int spscChannel::numInFlight(){
+    unsigned t = this->staged ? this->visibleTail : this->tail.load(std::memory_order_acquire);
+    return t - this->head.load(std::memory_order_acquire);
+}
+
+// Puts a packet into the channel - producer only
+void spscChannel::put(packet data){
+    unsigned t = this->tail.load(std::memory_order_relaxed);
+    if(t - this->head.load(std::memory_order_acquire) > (unsigned)this->mask || this->overflow.size() > 0){
+        // The consumer may be reading the ring buffer on another thread, so it is never resized
+	// The packet is held until flush finds room for it
+	this->overflow.push_back(data);
+	return;
+    }
+    this->messages[t & this->mask] = data;
+    this->tail.store(t + 1, std::memory_order_release); // The packet is written before the consumer can see it
+};
+
+// While staged, the consumer can't see packets put after the cycle started
+void spscChannel::stage(bool on){
+    if(on){
+        this->visibleTail = this->tail.load(std::memory_order_acquire);
+    }
+    this->staged = on;
+}
+
+// Moves as many of the puts that didn't fit in the ring buffer into it as there is room for - producer only
+// Kernels are allowed to preload more packets than maxInFlight, so the rest wait here until the consumer makes room
+void spscChannel::flush(){
+    unsigned t = this->tail.load(std::memory_order_relaxed);
+    unsigned moved = 0;
+    while(moved < this->overflow.size() && t - this->head.load(std::memory_order_acquire) <= (unsigned)this->mask){
+        this->messages[t & this->mask] = this->overflow[moved];
+	t++;
+	moved++;
+    }
+    this->tail.store(t, std::memory_order_release);
+    this->overflow.erase(this->overflow.begin(), this->overflow.begin() + moved);
+    if(this->staged){
+        this->visibleTail = t;
+    }
+}
+
+#endif
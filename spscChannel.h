@@ -0,0 +1,44 @@
+// Header File for the Lock-Free Single Producer Single Consumer Channel
+#ifndef SPSC_CHANNEL_H
+#define SPSC_CHANNEL_H
+
+#include<iostream>
+#include<vector>
+#include<atomic>
+using namespace std;
+
+#include"liChannel.h"
+
+// Size of a cache line - head and tail live on their own lines so the producer and consumer don't fight over one
+#define CACHE_LINE 64
+
+/*
+An liChannel that one thread can put into while another thread gets
+from it, without a lock.  Only the producer moves tail and only the
+consumer moves head, so each index has one writer.
+While the simulator has the channel staged, the consumer only sees the
+packets that were in the channel when the cycle started, which keeps
+parallel runs identical to serial ones without copying every put.
+The ring buffer is never resized, since the consumer could be reading
+it.  Puts that don't fit wait in an overflow list that only the
+producer touches, and flush moves them in as the consumer makes room.
+*/
+class spscChannel : public liChannel{
+    public:
+	spscChannel(int maxInFlight);  // Constructor that takes the maximum packets in flight for this channel
+	packet get();                  // Gets a packet from the channel - consumer only
+	packet peek();                 // Peeks at a packet in the channel - consumer only
+	void put(packet data);         // Puts a packet into the channel - producer only
+	int numInFlight();             // Gets number of messages in flight
+	void stage(bool on);           // While staged, the consumer can't see packets put after the cycle started
+	void flush();                  // Moves puts that didn't fit in the ring buffer into it as room frees - producer only
+
+    private:
+	alignas(CACHE_LINE) std::atomic<unsigned> head; // Count of packets ever gotten - only the consumer writes it
+	alignas(CACHE_LINE) std::atomic<unsigned> tail; // Count of packets ever put - only the producer writes it
+	alignas(CACHE_LINE) unsigned visibleTail;       // Tail when the channel was staged
+	bool staged;                                    // Is the consumer limited to visibleTail
+	std::vector<packet> overflow;                   // Puts that didn't fit in the ring buffer, oldest first
+};
+
+#endif
@@ -0,0 +1,45 @@
+///////////////////////////////////
+// Design Space Sweep
+// Date   - 10/18/26
+//////////////////////////////////
+#ifndef TIMING_CPP
+#define TIMING_CPP
+
+/*
+This program runs every point of a parameter grid on a netlist,
+on all cores, and writes one table of results.  Run it as:
+
+    ./sweep <sweep file> [threads]
+
+The sweep file format is described at the top of sweepRunner.h.
+*/
+
+
+#include"timingModel.h"
+using namespace std;
+
+
+int main(int argc, char ** argv){
+    if(argc < 2){
+        printf("Usage: %s <sweep file> [threads]\n", argv[0]);
+	return 1;
+    }
+
+    SweepRunner sweep;
+    if(!sweep.load(argv[1])){
+        return 1;
+    }
+
+    // Use every core unless told otherwise
+    int threads = std::thread::hardware_concurrency();
+    if(argc > 2){
+        threads = atoi(argv[2]);
+    }
+
+    fprintf(stderr, "Running %i points on %i threads\n", sweep.getNumPoints(), threads);
+    if(!sweep.run(threads)){
+        return 1;
+    }
+    return sweep.write(sweep.outputFile.c_str()) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,296 @@
+///////////////////////////////////
+// Sweep Runner
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This file runs a design space sweep.  Every point of the grid
+gets its own Simulator and Netlist, so points share nothing but
+the base cycle times and can run on any thread.  Each simulation
+runs on a single thread since the sweep already uses every core.
+*/
+
+#ifndef SWEEPRUNNER_CPP
+#define SWEEPRUNNER_CPP
+
+#include"sweepRunner.h"
+
+static const char * stopNames[] = {"RUNNING", "QUIESCENT", "MAX_CYCLES", "MAX_WALLCLOCK", "BAD_CYCLE_TIMES"};
+
+// Writes a string with the characters JSON cares about escaped
+static void writeJSONString(FILE * out, const std::string &text){
+    fputc('"', out);
+    for(unsigned i=0; i < text.size(); i++){
+        if(text[i] == '"' || text[i] == '\\'){
+	    fputc('\\', out);
+	}
+	fputc(text[i], out);
+    }
+    fputc('"', out);
+}
+
+// Empty Constructor
+SweepRunner::SweepRunner(){
+    this->cycleFile = "cycleTimes.cfg";
+    this->maxCycles = 0;
+};
+
+// Reads a sweep file - false on an error
+bool SweepRunner::load(const char * fileName){
+    std::ifstream data(fileName);
+    if(!data.is_open()){
+        fprintf(stderr, "Could not open sweep file %s\n", fileName);
+        return false;
+    }
+
+    std::string line;
+    int lineNum = 0;
+    while(std::getline(data, line)){
+        lineNum++;
+	std::stringstream tokens(line.substr(0, line.find('#')));
+	std::string keyword, value;
+	if(!(tokens >> keyword)){
+	    continue;  // Blank line
+	}
+	if(!(tokens >> value)){
+	    fprintf(stderr, "Sweep line %i: %s needs a value\n", lineNum, keyword.c_str());
+	    return false;
+	}
+	if(keyword == "netlist"){
+	    this->netlistFile = value;
+	}
+	else if(keyword == "cycles"){
+	    this->cycleFile = value;
+	}
+	else if(keyword == "output"){
+	    this->outputFile = value;
+	}
+	else if(keyword == "maxCycles"){
+	    this->maxCycles = atoi(value.c_str());
+	}
+	else if(keyword == "param"){
+	    std::vector<std::string> values;
+	    std::string v;
+	    while(tokens >> v){
+	        values.push_back(v);
+	    }
+	    if(values.size() == 0){
+	        fprintf(stderr, "Sweep line %i: param %s needs at least one value\n", lineNum, value.c_str());
+		return false;
+	    }
+	    this->addParam(value, values);
+	}
+	else{
+	    fprintf(stderr, "Sweep line %i: unknown keyword %s\n", lineNum, keyword.c_str());
+	    return false;
+	}
+    }
+    if(this->netlistFile.size() == 0){
+        fprintf(stderr, "Sweep file %s doesn't name a netlist\n", fileName);
+	return false;
+    }
+    return true;
+};
+
+// Adds one axis to the grid
+void SweepRunner::addParam(const std::string &key, const std::vector<std::string> &values){
+    this->params.push_back(make_pair(key, values));
+};
+
+// Number of points in the grid
+int SweepRunner::getNumPoints(){
+    int num = 1;
+    for(unsigned i=0; i < this->params.size(); i++){
+        num *= this->params[i].second.size();
+    }
+    return num;
+};
+
+// Runs every point of the grid, threads at a time - false if the cycle times can't be loaded
+bool SweepRunner::run(int threads){
+    if(!this->baseTimes.load(this->cycleFile.c_str())){
+        return false;
+    }
+
+    // The first param changes slowest, like nested loops in the order the params were given
+    int numPoints = this->getNumPoints();
+    this->points.assign(numPoints, SweepPoint());
+    for(int p=0; p < numPoints; p++){
+        int rest = p;
+        this->points[p].choice.assign(this->params.size(), 0);
+	for(int i=this->params.size() - 1; i >= 0; i--){
+	    this->points[p].choice[i] = rest % this->params[i].second.size();
+	    rest /= this->params[i].second.size();
+	}
+    }
+
+    if(threads < 1){
+        threads = 1;
+    }
+    ThreadPool pool(min(threads, numPoints));
+    pool.run(SweepRunner::runPointTask, this, numPoints);
+    return true;
+};
+
+// Entry point for the thread pool
+void SweepRunner::runPointTask(void * runner, int index){
+    static_cast<SweepRunner *>(runner)->runPoint(index);
+};
+
+// Runs the simulation for one point
+void SweepRunner::runPoint(int index){
+    SweepPoint &point = this->points[index];
+    point.ok = false;
+    point.totalTime = 0;
+    point.numCycles = 0;
+    point.stopReason = RUNNING;
+    point.numOutputs = 0;
+    point.lastOutput = 0;
+
+    CycleTimes times = this->baseTimes;
+    Netlist net;
+    net.setPrivateMemories(true);  // Points run at once on the same netlist, so none of them can write to a shared memory file
+    for(unsigned i=0; i < this->params.size(); i++){
+        const std::string &key = this->params[i].first;
+	const std::string &value = this->params[i].second[point.choice[i]];
+	if(key.compare(0, 5, "time.") == 0){
+	    // time.<module>.<phase>.<instruction>
+	    std::stringstream names(key.substr(5));
+	    std::string module, phase, inst;
+	    std::getline(names, module, '.');
+	    std::getline(names, phase, '.');
+	    std::getline(names, inst, '.');
+	    if(!times.set(module, phase, inst, atoi(value.c_str()))){
+	        fprintf(stderr, "Sweep param %s isn't a cycle time\n", key.c_str());
+		return;
+	    }
+	}
+	else{
+	    net.set(key, value);
+	}
+    }
+
+    Simulator sim(times);
+    sim.setEventDriven(true);
+    if(this->maxCycles > 0){
+        sim.setMaxCycles(this->maxCycles);
+    }
+    if(!net.load(this->netlistFile.c_str(), &sim)){
+        return;
+    }
+
+    while(!sim.done()){
+        sim.beginCycle();
+	sim.evaluate();
+	for(unsigned i=0; i < net.watched.size(); i++){
+	    if(net.watched[i].second->getCanPop()){
+	        point.lastOutput = net.watched[i].second->get().data;
+		point.numOutputs++;
+	    }
+	}
+	sim.endCycle();
+    }
+
+    point.ok = true;
+    point.totalTime = sim.getTotalTime();
+    point.numCycles = sim.getNumCycles();
+    point.stopReason = sim.getStopReason();
+    for(int t=0; t < NUM_MODULE_TYPES; t++){
+        ModuleType type = static_cast<ModuleType>(t);
+        for(int m=0; m < sim.getNumModules(type); m++){
+	    point.modules.push_back(make_pair(type, net.getName(type, m)));
+	    point.stats.push_back(sim.getStats(type, m));
+	}
+    }
+};
+
+// Writes the results - .json is JSON, anything else is CSV
+bool SweepRunner::write(const char * fileName){
+    if(fileName == NULL || fileName[0] == '\0'){
+        this->writeCSV(stdout);
+	return true;
+    }
+    FILE * out = fopen(fileName, "w");
+    if(out == NULL){
+        fprintf(stderr, "Could not open %s for the sweep results\n", fileName);
+	return false;
+    }
+    std::string name(fileName);
+    if(name.size() >= 5 && name.compare(name.size() - 5, 5, ".json") == 0){
+        this->writeJSON(out);
+    }
+    else{
+        this->writeCSV(out);
+    }
+    fclose(out);
+    return true;
+};
+
+// One row per point - the module columns come from the first point that ran
+void SweepRunner::writeCSV(FILE * out){
+    SweepPoint * first = NULL;
+    for(unsigned p=0; p < this->points.size() && first == NULL; p++){
+        if(this->points[p].ok){
+	    first = &this->points[p];
+	}
+    }
+
+    for(unsigned i=0; i < this->params.size(); i++){
+        fprintf(out, "%s,", this->params[i].first.c_str());
+    }
+    fprintf(out, "ok,totalTime,cycles,stop,outputs,lastOutput");
+    if(first != NULL){
+        for(unsigned m=0; m < first->modules.size(); m++){
+	    const char * name = first->modules[m].second.c_str();
+	    fprintf(out, ",%s.cycles,%s.busy,%s.time,%s.highWater,%s.stalls,%s.hits,%s.misses,%s.evictions", name, name, name, name, name,
+	            name, name, name);
+	}
+    }
+    fprintf(out, "\n");
+
+    for(unsigned p=0; p < this->points.size(); p++){
+        SweepPoint &point = this->points[p];
+	for(unsigned i=0; i < this->params.size(); i++){
+	    fprintf(out, "%s,", this->params[i].second[point.choice[i]].c_str());
+	}
+	fprintf(out, "%i,%i,%i,%s,%i,%i", point.ok ? 1 : 0, point.totalTime, point.numCycles,
+	        stopNames[point.stopReason], point.numOutputs, point.lastOutput);
+	for(unsigned m=0; m < point.stats.size(); m++){
+	    fprintf(out, ",%i,%i,%lli,%i,%i,%i,%i,%i", point.stats[m].cycles, point.stats[m].busy, point.stats[m].time,
+	            point.stats[m].highWater, point.stats[m].stalls, point.stats[m].hits, point.stats[m].misses, point.stats[m].evictions);
+	}
+	fprintf(out, "\n");
+    }
+};
+
+// One object per point
+void SweepRunner::writeJSON(FILE * out){
+    fprintf(out, "[\n");
+    for(unsigned p=0; p < this->points.size(); p++){
+        SweepPoint &point = this->points[p];
+	fprintf(out, "  {\"params\": {");
+	for(unsigned i=0; i < this->params.size(); i++){
+	    writeJSONString(out, this->params[i].first);
+	    fprintf(out, ": ");
+	    writeJSONString(out, this->params[i].second[point.choice[i]]);
+	    fputs(i + 1 < this->params.size() ? ", " : "", out);
+	}
+	fprintf(out, "}, \"ok\": %s, \"totalTime\": %i, \"cycles\": %i, \"stop\": \"%s\", \"outputs\": %i, \"lastOutput\": %i,\n",
+	        point.ok ? "true" : "false", point.totalTime, point.numCycles, stopNames[point.stopReason],
+		point.numOutputs, point.lastOutput);
+	fprintf(out, "   \"modules\": [");
+	for(unsigned m=0; m < point.stats.size(); m++){
+	    fprintf(out, "\n    {\"name\": ");
+	    writeJSONString(out, point.modules[m].second);
+	    fprintf(out, ", \"type\": \"%s\", \"cycles\": %i, \"busy\": %i, \"time\": %lli, \"highWater\": %i, \"stalls\": %i,"
+	            " \"hits\": %i, \"misses\": %i, \"evictions\": %i}%s",
+	            CycleTimes::moduleName(point.modules[m].first), point.stats[m].cycles, point.stats[m].busy,
+		    point.stats[m].time, point.stats[m].highWater, point.stats[m].stalls, point.stats[m].hits,
+		    point.stats[m].misses, point.stats[m].evictions, m + 1 < point.stats.size() ? "," : "");
+	}
+	fprintf(out, "]}%s\n", p + 1 < this->points.size() ? "," : "");
+    }
+    fprintf(out, "]\n");
+};
+
+#endif
@@ -0,0 +1,80 @@
+///////////////////////////////////
+// Sweep Runner Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for the design space sweep runner.
+A sweep takes one netlist and a grid of parameters, runs a
+simulation for every point of the grid on all cores, and
+writes one table with the time and module stats of each point.
+A sweep file has one keyword per line, and # starts a comment:
+
+    netlist <netlist file>
+    cycles <cycle time file>
+    output <results file>          .json writes JSON, anything else writes CSV
+    maxCycles <n>                  stops a point that never goes quiescent
+    param <key> <value> <value> ...
+
+A param key is anything Netlist::set takes, like f1.size, t1.regs,
+or *.capacity, or a cycle time written time.<module>.<phase>.<instruction>
+with the names from the cycle time file, like time.TIA.Execute.ADD.
+Every combination of the param values is run.  A param that no line of
+the netlist takes is reported, and every point is marked not ok.
+Every point maps the netlist's memory files privately, so points never
+see each other's writes and the files are left alone.  A memory file
+must already hold the whole memory to be swept.
+*/
+
+#ifndef SWEEPRUNNER_H
+#define SWEEPRUNNER_H
+
+#include<vector>
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<stdlib.h>
+#include<stdio.h>
+using namespace std;
+
+#include"netlist.cpp"
+
+// Results of one point of the grid
+struct SweepPoint{
+    std::vector<int> choice;                  // Which value of each param this point uses
+    bool ok;                                  // False if the netlist or a param couldn't be applied
+    int totalTime;
+    int numCycles;
+    StopReason stopReason;
+    int numOutputs;                           // Packets that reached watched channels
+    int lastOutput;                           // Data of the last one, so a sweep can check the answer didn't change
+    std::vector<pair<ModuleType, std::string> > modules; // Type and name of each module
+    std::vector<ModuleStats> stats;           // Stats of each module, lined up with modules
+};
+
+class SweepRunner{
+    public:
+	SweepRunner();                                                      // Empty Constructor
+	bool load(const char * fileName);                                   // Reads a sweep file - false on an error
+	void addParam(const std::string &key, const std::vector<std::string> &values); // Adds one axis to the grid
+	int getNumPoints();                                                 // Number of points in the grid
+	bool run(int threads);                                              // Runs every point of the grid, threads at a time - false if the cycle times can't be loaded
+	bool write(const char * fileName);                                  // Writes the results - .json is JSON, anything else is CSV
+	void writeCSV(FILE * out);                                          // One row per point
+	void writeJSON(FILE * out);                                         // One object per point
+	std::vector<SweepPoint> points;                                     // Results, in grid order once run returns
+
+	std::string netlistFile;
+	std::string cycleFile;
+	std::string outputFile;                                             // Empty writes CSV to stdout
+	int maxCycles;
+
+    private:
+	std::vector<pair<std::string, std::vector<std::string> > > params;  // Key and values of each axis of the grid
+	CycleTimes baseTimes;                                               // Cycle times before the time params are applied
+	void runPoint(int index);                                           // Runs the simulation for one point
+	static void runPointTask(void * runner, int index);                 // Entry point for the thread pool
+};
+
+#endif
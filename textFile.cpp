@@ -0,0 +1,48 @@
+///////////////////////////////////
+// Text File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This file has the helpers that every text file reader shares.
+*/
+
+#ifndef TEXTFILE_CPP
+#define TEXTFILE_CPP
+
+#include"textFile.h"
+
+// Reads one line that ends with \n, \r\n, or \r - false once there are no more
+// Lines can end any of those ways depending on who saved the file
+bool readLine(std::istream &in, std::string &line){
+    line.clear();
+    char c;
+    if(!in.get(c)){
+        return false;
+    }
+    while(c != '\n'){
+        if(c == '\r'){
+	    if(in.peek() == '\n'){
+	        in.get(c);
+	    }
+	    return true;
+	}
+	line += c;
+	if(!in.get(c)){
+	    return true;  // Last line with no ending
+	}
+    }
+    return true;
+};
+
+// Parses an integer and makes sure there is nothing left over
+// Numbers are decimal even with leading zeros, like 010, unless they start with 0x
+bool parseInt(const std::string &text, int &value){
+    size_t digits = (text.size() > 0 && (text[0] == '-' || text[0] == '+')) ? 1 : 0;
+    bool hex = text.compare(digits, 2, "0x") == 0 || text.compare(digits, 2, "0X") == 0;
+    char * end;
+    value = (int)strtol(text.c_str(), &end, hex ? 16 : 10);
+    return text.size() > 0 && *end == '\0';
+};
+
+#endif
@@ -0,0 +1,22 @@
+///////////////////////////////////
+// Text File Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for the helpers that every text file
+reader shares - the cycle time file, netlists, and TIA programs.
+*/
+
+#ifndef TEXTFILE_H
+#define TEXTFILE_H
+
+#include<iostream>
+#include<string>
+#include<stdlib.h>
+using namespace std;
+
+bool readLine(std::istream &in, std::string &line);     // Reads one line that ends with \n, \r\n, or \r - false once there are no more
+bool parseInt(const std::string &text, int &value);     // Parses a decimal or 0x hex integer and makes sure there is nothing left over
+
+#endif
@@ -0,0 +1,103 @@
+///////////////////////////////////
+// Thread Pool
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is a small fixed-size thread pool.  run hands out tasks
+to the workers, and the calling thread takes tasks too, so
+nobody sits idle while the batch runs.
+*/
+
+#ifndef THREADPOOL_CPP
+#define THREADPOOL_CPP
+
+#include"threadPool.h"
+
+// Starts numThreads workers
+ThreadPool::ThreadPool(int numThreads){
+    this->task = NULL;
+    this->context = NULL;
+    this->numTasks = 0;
+    this->nextTask = 0;
+    this->tasksLeft = 0;
+    this->batch = 0;
+    this->stopping = false;
+    // The thread that calls run works too, so we only need numThreads - 1 helpers
+    for(int i=1; i < numThreads; i++){
+        this->workers.push_back(std::thread(&ThreadPool::work, this));
+    }
+};
+
+// Stops and joins the workers
+ThreadPool::~ThreadPool(){
+    {
+        std::unique_lock<std::mutex> guard(this->lock);
+	this->stopping = true;
+    }
+    this->start.notify_all();
+    for(int i=0; i < this->workers.size(); i++){
+        this->workers[i].join();
+    }
+};
+
+// Runs tasks 0 to numTasks - 1 and waits until they are all done
+void ThreadPool::run(PoolTask task, void * context, int numTasks){
+    std::unique_lock<std::mutex> guard(this->lock);
+    this->task = task;
+    this->context = context;
+    this->numTasks = numTasks;
+    this->nextTask = 0;
+    this->tasksLeft = numTasks;
+    this->batch++;
+    this->start.notify_all();
+
+    // Take tasks ourselves until there are none left to hand out
+    while(this->nextTask < this->numTasks){
+        int t = this->nextTask++;
+	guard.unlock();
+	task(context, t);
+	guard.lock();
+	this->tasksLeft--;
+    }
+    while(this->tasksLeft > 0){
+        this->finished.wait(guard);
+    }
+};
+
+// Number of workers, counting the thread that calls run
+int ThreadPool::getNumThreads(){
+    return this->workers.size() + 1;
+};
+
+// Loop that every worker runs
+void ThreadPool::work(){
+    std::unique_lock<std::mutex> guard(this->lock);
+    int seen = 0;
+    while(true){
+        while(!this->stopping && (this->batch == seen || this->nextTask >= this->numTasks)){
+	    if(this->batch != seen && this->nextTask >= this->numTasks){
+	        seen = this->batch;  // Everything in this batch was handed out already
+	    }
+	    this->start.wait(guard);
+	}
+	if(this->stopping){
+	    return;
+	}
+	seen = this->batch;
+	while(this->nextTask < this->numTasks){
+	    int t = this->nextTask++;
+	    PoolTask task = this->task;
+	    void * context = this->context;
+	    guard.unlock();
+	    task(context, t);
+	    guard.lock();
+	    this->tasksLeft--;
+	    if(this->tasksLeft == 0){
+	        this->finished.notify_all();
+	    }
+	}
+    }
+};
+
+#endif
@@ -0,0 +1,51 @@
+///////////////////////////////////
+// Thread Pool Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for the thread pool that the simulator
+uses to evaluate partitions of a fabric in parallel.
+The workers are started once and then woken up every cycle,
+so a cycle only costs a wakeup and a barrier instead of
+creating threads.
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include<vector>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+using namespace std;
+
+// Function that runs one task - gets the context passed to run and the task number
+typedef void (*PoolTask)(void * context, int task);
+
+class ThreadPool{
+    public:
+	ThreadPool(int numThreads);                          // Starts numThreads workers
+	~ThreadPool();                                       // Stops and joins the workers
+	void run(PoolTask task, void * context, int numTasks); // Runs tasks 0 to numTasks - 1 and waits until they are all done
+	int getNumThreads();                                 // Number of workers
+
+    private:
+	ThreadPool(const ThreadPool &);                      // Threads can't be copied
+	ThreadPool & operator=(const ThreadPool &);
+	void work();                                         // Loop that every worker runs
+
+	std::vector<std::thread> workers;
+	std::mutex lock;
+	std::condition_variable start;                       // Signals workers that a new batch of tasks is ready
+	std::condition_variable finished;                    // Signals run that the batch is done
+	PoolTask task;
+	void * context;
+	int numTasks;
+	int nextTask;                                        // Next task to hand out
+	int tasksLeft;                                       // Tasks in this batch that haven't finished
+	int batch;                                           // Counts batches so workers can tell a new one started
+	bool stopping;
+};
+
+#endif
@@ -14,6 +14,7 @@ This is the module for the TIA processing element.
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 using namespace std;
 
 #include "baseclass.cpp"
@@ -22,7 +23,7 @@ using namespace std;
 #define T_WRITE 0
 
 // Defining constructor for the TIA class
-TIA::TIA(multiChannel * hChans, multiChannel * iChans, multiChannel * oChans, int numPReg, int numDReg){
+TIA::TIA(multiChannel * hChans, multiChannel * iChans, multiChannel * oChans, int numPReg, int numDReg, int width, IssuePolicy policy, int depth){
     this->helpChans = hChans;        // Assign Helper Channels
     this->inputChans = iChans;       // Assign Input Channels
     this->outputChans = oChans;      // Assign Output Channels
@@ -37,24 +38,42 @@ TIA::TIA(multiChannel * hChans, multiChannel * iChans, multiChannel * oChans, in
     for(int i=0;i<numDReg;i++){
         this->dataRegScore.push_back(false);      // Initialize scoreboard to all false for data regs
     }
+    // Trigger bitmasks can only be used if every register and channel gets its own bit
+    this->masksFit = numPReg <= TIA_MASK_BITS && numDReg <= TIA_MASK_BITS && iChans->getNumChannels() <= TIA_MASK_BITS && oChans->getNumChannels() <= TIA_MASK_BITS;
+
+    this->issueWidth = width < 1 ? 1 : width; // We can always issue at least one instruction
+    this->issuePolicy = policy;
+    this->nextRR = 0;
+    this->scheduleCycle = 0;
+    this->pipelineDepth = depth < 1 ? 1 : depth;
+    this->loadingShadow = false;
+    this->loadWidth = 1;
+    this->wordsLoaded = 0;
+    this->swapped = false;
+    this->totalWordsLoaded = 0;
+    this->numSwaps = 0;
+    for(int i=0;i<oChans->getNumChannels();i++){
+        this->outClaimed.push_back(false);
+    }
 };
 
-// Add Instruction to instruction bank
-void TIA::addInstruction(TIAinstruction newInst){
+// Checks that an instruction only uses registers and channels that this TIA has
+// Programs can arrive as words over T_WRITE, so every index has to be checked before it is used
+bool TIA::legal(const TIAinstruction &newInst){
     // Checks that all instructions added are legal - can be run
     // Set "legal" flag to start as true and then check it at the end
     bool legal = true;
 
     // Check that required predicate state is possible
     for(int i=0; i < newInst.getPredState().size(); i++){
-        if(newInst.getPredState()[i].first >= this->predRegs.getNumRegs()){
+        if(newInst.getPredState()[i].first < 0 || newInst.getPredState()[i].first >= this->predRegs.getNumRegs()){
 	    legal = false;
 	}
     }
 
     // Check that required input flags are possible
     for(int i=0; i < newInst.getInputFlags().size(); i++){
-        if(newInst.getInputFlags()[i].first >= this->inputChans->getNumChannels()){
+        if(newInst.getInputFlags()[i].first < 0 || newInst.getInputFlags()[i].first >= this->inputChans->getNumChannels()){
 	    legal = false;
 	}
     }
@@ -62,90 +81,348 @@ void TIA::addInstruction(TIAinstruction newInst){
     // Check that inputs are valid
     for(int i=0; i < newInst.getInput().size(); i++){
         if(newInst.getInput()[i].first == 0){ // This input is from an input channel
-            if(newInst.getInput()[i].second >= this->inputChans->getNumChannels()){
+            if(newInst.getInput()[i].second < 0 || newInst.getInput()[i].second >= this->inputChans->getNumChannels()){
 	        legal = false;
 	    }
 	}
 	else if(newInst.getInput()[i].first == 1){ // This input is from a data register
-	    if(newInst.getInput()[i].second >= this->dataRegs.getNumRegs()){
+	    if(newInst.getInput()[i].second < 0 || newInst.getInput()[i].second >= this->dataRegs.getNumRegs()){
 	        legal = false;
 	    }
 	}
     }
 
+    // Check that dequeued channels exist
+    for(int i=0; i < newInst.getDequeue().size(); i++){
+        if(newInst.getDequeue()[i] < 0 || newInst.getDequeue()[i] >= this->inputChans->getNumChannels()){
+	    legal = false;
+	}
+    }
+
+    // Check that updated predicate and data registers exist
+    for(int i=0; i < newInst.getPredUpdates().size(); i++){
+        if(newInst.getPredUpdates()[i].second.first < 0 || newInst.getPredUpdates()[i].second.first >= this->predRegs.getNumRegs()){
+	    legal = false;
+	}
+    }
+    for(int i=0; i < newInst.getDataRegUpdates().size(); i++){
+        if(newInst.getDataRegUpdates()[i].first < 0 || newInst.getDataRegUpdates()[i].first >= this->dataRegs.getNumRegs()){
+	    legal = false;
+	}
+    }
+
+    // Check that the instruction fits in a Dynamic_TIAinstruction
+    if(newInst.getInput().size() > MAX_RESULTS || newInst.getPredUpdates().size() > MAX_PRED_UPDATES){
+        legal = false;
+    }
+
     // Check that outputs are valid
     for(int i=0; i < newInst.getOutput().size(); i++){
 	if(newInst.getOutput()[i].first){ // This output is for an output channel
-            if(newInst.getOutput()[i].second >= this->outputChans->getNumChannels()){
+            if(newInst.getOutput()[i].second < 0 || newInst.getOutput()[i].second >= this->outputChans->getNumChannels()){
 	        legal = false;
 	    }
 	}
 	else{ // This output is for a data register
-	    if(newInst.getOutput()[i].second >= this->dataRegs.getNumRegs()){
+	    if(newInst.getOutput()[i].second < 0 || newInst.getOutput()[i].second >= this->dataRegs.getNumRegs()){
 	        legal = false;
 	    }
 	}
     }
 
+    return legal;
+}
 
+// Add Instruction to instruction bank
+void TIA::addInstruction(const TIAinstruction &newInst){
     // Only add instruction if it is actually legal
-    if(legal){
+    if(this->legal(newInst)){
         this->iMem.push_back(newInst);
+        this->triggers.push_back(this->lower(newInst));
+        this->readySince.push_back(-1);
+    }
+    else{
+        fprintf(stderr, "TIA dropped a %s that uses a register or channel it doesn't have\n", CycleTimes::instructionName(static_cast<Instruction>(newInst.getCmd())));
     }
 }
 
-// Schedule and return a Dynamic Inst
-Dynamic_TIAinstruction TIA::schedule(){
-    if(this->helpChans->channels[T_WRITE]->getCanPop()){
-        // Any updates of the state of TIA or to iMem
-	TIAinstruction newInst = decode(this->helpChans->channels[T_WRITE]->get().data);
-        this->addInstruction(newInst);	
+// Lower the trigger conditions of an instruction into bitmasks
+// These must check exactly what canRun checks
+TIAtrigger TIA::lower(const TIAinstruction &inst){
+    TIAtrigger t;
+    t.lowered = this->masksFit;
+    t.never = false;
+    t.predMask = 0;
+    t.predValue = 0;
+    t.predFree = 0;
+    t.allPredsFree = false;
+    t.inReady = 0;
+    t.inFree = 0;
+    t.tagMask = 0;
+    t.tagValue = 0;
+    t.outSpace = 0;
+    t.dataFree = 0;
+
+    int index = 0;
+    tiaMask bit;
+
+    // Required predicate state - the predicate must have the right value and not be on the scoreboard
+    const std::vector<pair<int, bool> > &pState = inst.getPredState();
+    for(int j=0; j < pState.size(); j++){
+        index = pState[j].first;
+	if(index < 0 || index >= TIA_MASK_BITS){
+	    t.lowered = false;
+	    continue;
+	}
+	bit = 1ULL << index;
+	if((t.predMask & bit) && ((t.predValue & bit) != 0) != pState[j].second){
+	    t.never = true;
+	}
+	t.predMask |= bit;
+	if(pState[j].second){
+	    t.predValue |= bit;
+	}
+	t.predFree |= bit;
     }
 
-    std::vector<int> tList;
-    std::vector<Dynamic_TIAinstruction> toTrig;
+    // Inputs - channels must be able to pop, and channels and data regs must not be on the scoreboard
+    const std::vector<pair<int, int> > &input = inst.getInput();
+    for(int j=0; j < input.size(); j++){
+        index = input[j].second;
+	if(input[j].first != 0 && input[j].first != 1){ // Input is pred state
+	    t.allPredsFree = true;
+	    continue;
+	}
+	if(index < 0 || index >= TIA_MASK_BITS){
+	    t.lowered = false;
+	    continue;
+	}
+	bit = 1ULL << index;
+	if(input[j].first == 0){ // Input is channel
+	    t.inReady |= bit;
+	    t.inFree |= bit;
+	}
+	else{ // Input is Data Reg
+	    t.dataFree |= bit;
+	}
+    }
+
+    // Input flags - the tag at the head of the channel must match and the channel must not be on the scoreboard
+    const std::vector<pair<int, bool> > &iFlags = inst.getInputFlags();
+    for(int j=0; j < iFlags.size(); j++){
+        index = iFlags[j].first;
+	if(index < 0 || index >= TIA_MASK_BITS){
+	    t.lowered = false;
+	    continue;
+	}
+	bit = 1ULL << index;
+	if((t.tagMask & bit) && ((t.tagValue & bit) != 0) != iFlags[j].second){
+	    t.never = true;
+	}
+	t.tagMask |= bit;
+	if(iFlags[j].second){
+	    t.tagValue |= bit;
+	}
+	t.inFree |= bit;
+    }
+
+    // Outputs - channels must be able to push and data regs must not be on the scoreboard
+    const std::vector<pair<bool, int> > &output = inst.getOutput();
+    for(int j=0; j < output.size(); j++){
+        index = output[j].second;
+	if(index < 0 || index >= TIA_MASK_BITS){
+	    t.lowered = false;
+	    continue;
+	}
+	bit = 1ULL << index;
+	if(output[j].first){
+	    t.outSpace |= bit;
+	}
+	else{
+	    t.dataFree |= bit;
+	}
+    }
 
-    // See which instructions can trigger right now
-    tList = this->canTrigger();
+    // Predicate and data reg updates must not be on the scoreboard
+    const std::vector<pair<predUpdateType, pair<int, bool> > > &pUp = inst.getPredUpdates();
+    for(int j=0; j < pUp.size(); j++){
+        index = pUp[j].second.first;
+	if(index < 0 || index >= TIA_MASK_BITS){
+	    t.lowered = false;
+	    continue;
+	}
+	t.predFree |= 1ULL << index;
+    }
+    const std::vector<pair<int, int> > &drUp = inst.getDataRegUpdates();
+    for(int j=0; j < drUp.size(); j++){
+        index = drUp[j].first;
+	if(index < 0 || index >= TIA_MASK_BITS){
+	    t.lowered = false;
+	    continue;
+	}
+	t.dataFree |= 1ULL << index;
+    }
+
+    return t;
+}
+
+// Schedule up to issueWidth Dynamic Insts into bundle
+void TIA::schedule(std::vector<Dynamic_TIAinstruction> &bundle){
+    bundle.clear();
+
+    // Any updates to iMem come in through T_WRITE - while a new program waits to be swapped in, we let the old one drain
+    bool draining = this->load();
+    this->scheduleCycle++;
+
+    // See which instructions can trigger right now, and put them in the order we want to issue them
+    std::vector<int> tList = this->canTrigger();
+    this->orderReady(tList);
+
+    // Trigger ready instructions until we fill the issue width
+    // Triggering updates the scoreboards, so later instructions can't use resources that earlier ones
+    // or instructions still in flight are writing
+    for(int i=0; i < tList.size() && bundle.size() < this->issueWidth && !draining; i++){
+        int index = tList[i];
+	if((bundle.size() > 0 || this->inFlight.size() > 0) && this->conflicts(index)){
+	    continue;
+	}
 
-    // If we can trigger any instructions, just trigger the first for now
-    if(tList.size() > 0){
-        Dynamic_TIAinstruction runInst(tList[0], static_cast<Instruction>(iMem[tList[0]].getCmd()));
-	toTrig.push_back(runInst);
-	this->trigger(toTrig);
-	return runInst;
+        Dynamic_TIAinstruction runInst(index, static_cast<Instruction>(iMem[index].getCmd()));
+	this->trigger(runInst);
+	bundle.push_back(runInst);
+
+	this->readySince[index] = -1;
+	this->nextRR = index + 1;
     }
 
-    
     // If we can't trigger any instructions, just input a NOP
-    Dynamic_TIAinstruction nop(-1, NOP);
-    return nop;
+    if(bundle.size() == 0){
+        Dynamic_TIAinstruction nop(-1, NOP);
+	bundle.push_back(nop);
+    }
 };
 
+// Put an executed bundle in flight and commit every instruction that has finished
+// With a depth of 1 the bundle commits right away, like schedule, execute, and commit back to back
+void TIA::advance(std::vector<Dynamic_TIAinstruction> &bundle){
+    if(this->pipelineDepth == 1 && this->inFlight.size() == 0){
+        for(int b=0; b < bundle.size(); b++){
+	    this->commit(bundle[b]);
+	}
+	return;
+    }
+
+    // Instructions commit depth - 1 cycles after they were scheduled
+    for(int b=0; b < bundle.size(); b++){
+        if(bundle[b].getIndex() != -1){
+	    this->inFlight.push_back(make_pair(this->scheduleCycle + this->pipelineDepth - 1, bundle[b]));
+	}
+    }
+
+    // In flight instructions are kept in the order they issued, so commit from the front
+    int done = 0;
+    while(done < this->inFlight.size() && this->inFlight[done].first <= this->scheduleCycle){
+        this->commit(this->inFlight[done].second);
+	done++;
+    }
+    if(done > 0){
+        this->inFlight.erase(this->inFlight.begin(), this->inFlight.begin() + done);
+    }
+}
+
+// Number of instructions in flight that have not committed
+int TIA::getNumInFlight(){
+    return this->inFlight.size();
+}
+
+// Sort ready instructions by the issue policy
+void TIA::orderReady(std::vector<int> &tList){
+    if(this->issuePolicy == OLDEST_READY){
+        // Age every ready instruction and forget the ones that are no longer ready
+	int t = 0;
+	for(int i=0; i < iMem.size(); i++){
+	    if(t < tList.size() && tList[t] == i){
+	        if(this->readySince[i] == -1){
+		    this->readySince[i] = this->scheduleCycle;
+		}
+		t++;
+	    }
+	    else{
+	        this->readySince[i] = -1;
+	    }
+	}
+	if(tList.size() < 2){
+	    return;
+	}
+	std::vector<pair<int, int> > order;
+	for(int i=0; i < tList.size(); i++){
+	    order.push_back(make_pair(this->readySince[tList[i]], tList[i]));
+	}
+	sort(order.begin(), order.end());
+	for(int i=0; i < tList.size(); i++){
+	    tList[i] = order[i].second;
+	}
+    }
+    else if(this->issuePolicy == ROUND_ROBIN && tList.size() > 1){
+        // tList is already in index order, so rotate it to start at the round robin pointer
+	int start = 0;
+	while(start < tList.size() && tList[start] < this->nextRR){
+	    start++;
+	}
+	rotate(tList.begin(), tList.begin() + start, tList.end());
+    }
+    // LOWEST_INDEX is the order canTrigger already returns
+}
+
+// Checks if an instruction can issue alongside the ones already issued this cycle
+bool TIA::conflicts(int index){
+    const TIAinstruction &inst = iMem[index];
+
+    // The scoreboards now hold the resources of the instructions we already issued
+    if(!this->canRun(inst)){
+        return true;
+    }
+    // Only one instruction can dequeue a channel
+    const std::vector<int> &dQ = inst.getDequeue();
+    for(int j=0; j < dQ.size(); j++){
+        if(dQ[j] < this->inChanScore.size() && this->inChanScore[dQ[j]]){
+	    return true;
+	}
+    }
+    // Only one instruction in flight can write to an output channel
+    const std::vector<pair<bool, int> > &output = inst.getOutput();
+    for(int j=0; j < output.size(); j++){
+        if(output[j].first && this->outClaimed[output[j].second]){
+	    return true;
+	}
+    }
+    return false;
+}
+
 // Execute a dynamic instruction and pass it back
 Dynamic_TIAinstruction TIA::execute(Dynamic_TIAinstruction inst){
     // Instruction is not a NOP - valid index into iMem
     if(inst.getIndex() != -1){
-        // Set instruction to correct iMem static inst
-	TIAinstruction instruction = iMem[inst.getIndex()];
+        // Refer to the correct iMem static inst without copying it
+	const TIAinstruction &instruction = iMem[inst.getIndex()];
 
-        std::vector<int> args, uncommittedResult;
-	std::vector<std::bitset<1> > tags;
+        // Arguments and their tags live in fixed arrays so that execute does not allocate
+        int args[MAX_RESULTS] = {0}, tags[MAX_RESULTS] = {0};
+	int numArgs = 0, numTags = 0;
 
-        // Grab the arguments from the input locations and throw them into the "args": vector
+        // Grab the arguments from the input locations and throw them into the "args" array
         for(int i=0; i< instruction.getInput().size(); i++){
             if(instruction.getInput()[i].first == 0){ // Get input from input channel
-                args.push_back(this->inputChans->channels[instruction.getInput()[i].second]->peek().data);
-		tags.push_back(this->inputChans->channels[instruction.getInput()[i].second]->peek().tag);
+                args[numArgs++] = this->inputChans->channels[instruction.getInput()[i].second]->peek().data;
+		tags[numTags++] = (int)this->inputChans->channels[instruction.getInput()[i].second]->peek().tag.to_ulong();
             }
             else if(instruction.getInput()[i].first == 1){ // Get input from Data Reg
-                args.push_back(this->dataRegs.getValue(instruction.getInput()[i].second));
-		tags.push_back(0);
+                args[numArgs++] = this->dataRegs.getValue(instruction.getInput()[i].second);
+		tags[numTags++] = 0;
             }
 	    else{   // Get input from PredState
-		std::vector<pair<int, bool> > pState;
+		const std::vector<pair<int, bool> > &pState = instruction.getPredState();
 		int predStateInt;
-		pState = instruction.getPredState();
 		std::bitset<32> pBits;
 		for(int s=0; s< pState.size(); s++){
 	            if(s< 32){
@@ -158,7 +435,7 @@ Dynamic_TIAinstruction TIA::execute(Dynamic_TIAinstruction inst){
 		    }
 		}
 		predStateInt = (int)pBits.to_ulong();
-		args.push_back(predStateInt);
+		args[numArgs++] = predStateInt;
 	    }
         }
 
@@ -166,76 +443,74 @@ Dynamic_TIAinstruction TIA::execute(Dynamic_TIAinstruction inst){
         // Run the command specified by the instruction and store it in the instruction
         switch(instruction.getCmd()){
             case PLUSPLUS:
-                uncommittedResult.push_back(args[0] + 1); 
+                inst.addResult(args[0] + 1); 
                 break;
             case MINUSMINUS:
-                uncommittedResult.push_back(args[0] - 1);
+                inst.addResult(args[0] - 1);
                 break;
             case ADD:
-                uncommittedResult.push_back(args[0] + args[1]);
+                inst.addResult(args[0] + args[1]);
                 break;
             case SUBTRACT:
-                uncommittedResult.push_back(args[0] - args[1]);
+                inst.addResult(args[0] - args[1]);
                 break;
             case LESS_THAN:
-                uncommittedResult.push_back((args[0] < args[1]) ? 1 : 0);
+                inst.addResult((args[0] < args[1]) ? 1 : 0);
                 break;
             case GREATER_THAN:
-                uncommittedResult.push_back((args[0] > args[1]) ? 1 : 0);
+                inst.addResult((args[0] > args[1]) ? 1 : 0);
                 break;
             case LESS_THAN_EQUAL:
-                uncommittedResult.push_back((args[0] <= args[1]) ? 1 : 0);
+                inst.addResult((args[0] <= args[1]) ? 1 : 0);
                 break;
             case GREATER_THAN_EQUAL:
-                uncommittedResult.push_back((args[0] >= args[1]) ? 1 : 0);
+                inst.addResult((args[0] >= args[1]) ? 1 : 0);
                 break;
 	    case PASS_THROUGH:
-		uncommittedResult.push_back(args[0]);
-		uncommittedResult.push_back((int)tags[0].to_ulong());
+		inst.addResult(args[0]);
+		inst.addResult(tags[0]);
 		break;
 	    case PASS_THROUGH_2:
-		uncommittedResult.push_back(args[0]);
-		uncommittedResult.push_back((int)tags[0].to_ulong());
-		uncommittedResult.push_back(args[1]);
-		uncommittedResult.push_back((int)tags[1].to_ulong());
+		inst.addResult(args[0]);
+		inst.addResult(tags[0]);
+		inst.addResult(args[1]);
+		inst.addResult(tags[1]);
 		break;
 	    case DEQ:
-		uncommittedResult.push_back(args[0]);
+		inst.addResult(args[0]);
 		break;
 	    case SHIFT_RIGHT:
-		uncommittedResult.push_back(args[0] >> args[1]);
+		inst.addResult(args[0] >> args[1]);
 		break;
 	    case SHIFT_LEFT:
-		uncommittedResult.push_back(args[0] << args[1]);
+		inst.addResult(args[0] << args[1]);
 		break;
         }
 
-        inst.setUncommittedResult(uncommittedResult);
+        const int * uncommittedResult = inst.getUncommittedResult();
 
 
 	// Set predicate updates	
-        std::vector<pair<predUpdateType, pair<int, bool> > > predUp;
-	std::vector<pair<int, bool> > newPredUp;
-	predUp = instruction.getPredUpdates();
+        const std::vector<pair<predUpdateType, pair<int, bool> > > &predUp = instruction.getPredUpdates();
 	for(int h=0; h<predUp.size(); h++){
+	    pair<int, bool> update = predUp[h].second;
 	    switch(predUp[h].first){
 		case ANY: // Do Nothing
 		    break;
 	        case ZERO:
-		    predUp[h].second.second = uncommittedResult[0] == 0 ? true : false; 
+		    update.second = uncommittedResult[0] == 0 ? true : false; 
 	            break;
 		case LOB:
-		    predUp[h].second.second = (uncommittedResult[0] & 1) == 1 ? true : false;
+		    update.second = (uncommittedResult[0] & 1) == 1 ? true : false;
 		    break;
 		case HOB:
 		    unsigned int check;
 		    check = (unsigned int)uncommittedResult[0];
-		    predUp[h].second.second = (check >> 31) == 1 ? true: false;
+		    update.second = (check >> 31) == 1 ? true: false;
 		    break;
 	    }
-	    newPredUp.push_back(predUp[h].second);
+	    inst.addPredUpdate(update.first, update.second);
 	}
-	inst.setPredUpdates(newPredUp);
     }
 
     // Return the instruction so that you have the uncommitted result
@@ -243,11 +518,11 @@ Dynamic_TIAinstruction TIA::execute(Dynamic_TIAinstruction inst){
 };
 
 // Commit dynamic instruction
-void TIA::commit(Dynamic_TIAinstruction inst){
+void TIA::commit(Dynamic_TIAinstruction &inst){
     // Check if the instruction is a nop
     if(inst.getIndex() != -1){
-        // Grab correct iMem inst
-	TIAinstruction instruction = iMem[inst.getIndex()];
+        // Refer to the correct iMem inst without copying it
+	const TIAinstruction &instruction = iMem[inst.getIndex()];
 
 	struct packet p, p2;
 
@@ -323,11 +598,18 @@ void TIA::commit(Dynamic_TIAinstruction inst){
 		break;
         }
 
-        
+
+        // Release the output channels that this instruction claimed
+        const std::vector<pair<bool, int> > &oList = instruction.getOutput();
+        for(int i=0; i< oList.size(); i++){
+            if(oList[i].first){
+                this->outClaimed[oList[i].second] = false;
+            }
+        }
+
         // Dequeue any channels that the instruction commands
         if(instruction.getDequeue().size() > 0){
-            std::vector<int> dqList;
-            dqList = instruction.getDequeue();
+            const std::vector<int> &dqList = instruction.getDequeue();
             for (int i=0;i< dqList.size(); i++){
                 if(dqList[i] < inputChans->getNumChannels()){
                     this->inputChans->channels[dqList[i]]->get();
@@ -337,20 +619,16 @@ void TIA::commit(Dynamic_TIAinstruction inst){
         }
 
         // Update the predicate based on the instruction commands
-        if(inst.getPredUpdates().size() > 0){
-            std::vector<pair<int, bool> >predUpdates;
-            predUpdates = inst.getPredUpdates();
-            for (int i=0; i< predUpdates.size(); i++){
-                if(predUpdates[i].first < this->predRegs.getNumRegs()){
-                    this->predRegs.setValue(predUpdates[i].first, predUpdates[i].second);
-                }
+        const pair<int, bool> * predUpdates = inst.getPredUpdates();
+        for (int i=0; i< inst.getNumPredUpdates(); i++){
+            if(predUpdates[i].first < this->predRegs.getNumRegs()){
+                this->predRegs.setValue(predUpdates[i].first, predUpdates[i].second);
             }
         }
 
 	// Update the predicate scoreboard from possible predicate updates
 	if(instruction.getPredUpdates().size() > 0){
-	    std::vector<pair<predUpdateType, pair<int, bool> > > predUp;
-	    predUp = instruction.getPredUpdates();
+	    const std::vector<pair<predUpdateType, pair<int, bool> > > &predUp = instruction.getPredUpdates();
 	    for (int i=0; i< predUp.size(); i++){
                 if(predUp[i].second.first < this->predRegs.getNumRegs()){
             	    this->predScore[predUp[i].second.first] = false;
@@ -361,8 +639,7 @@ void TIA::commit(Dynamic_TIAinstruction inst){
 
 	// Update the data regs based on the instruction commands
 	if(instruction.getDataRegUpdates().size() > 0){
-            std::vector<pair<int, int> >drUpdates;
-            drUpdates = instruction.getDataRegUpdates();
+            const std::vector<pair<int, int> > &drUpdates = instruction.getDataRegUpdates();
             for (int i=0; i< drUpdates.size(); i++){
                 if(drUpdates[i].first < this->dataRegs.getNumRegs()){
                     this->dataRegs.setValue(drUpdates[i].first, drUpdates[i].second);
@@ -376,7 +653,7 @@ void TIA::commit(Dynamic_TIAinstruction inst){
 
 
 // Decides if a TIA instruction can run
-bool TIA::canRun(TIAinstruction inst){
+bool TIA::canRun(const TIAinstruction &inst){
     // Check Predicate Registers
     int index = 0;
     for(int j=0; j < inst.getPredState().size(); j++){
@@ -420,8 +697,11 @@ bool TIA::canRun(TIAinstruction inst){
     // Check the input flags
     for(int j=0; j < inst.getInputFlags().size(); j++){
         index = inst.getInputFlags()[j].first;
-	// Check if the tag matches the required tag
-	if(this->inputChans->channels[index]->peek().tag != inst.getInputFlags()[j].second){
+	// Check if there is a packet to look at and if its tag matches the required tag
+	if(this->inputChans->channels[index]->numInFlight() == 0){
+	    return false;
+	}
+	else if(this->inputChans->channels[index]->peek().tag != inst.getInputFlags()[j].second){
 	    return false;
 	}
 	// Check if the channel is already in use - scoreboard
@@ -464,60 +744,260 @@ bool TIA::canRun(TIAinstruction inst){
     return true;
 }
 
-// Return a TIAinstruction from common ones
-// Right now this just returns a NOP
-TIAinstruction TIA::decode(int index){
-    std::vector<pair<int, bool> > pred;
-    std::vector<pair<int, bool> > flags;
-    std::vector<pair<int, int> > inC, drU;
-    std::vector<pair<bool, int> > oC;
-    std::vector<int> dq;
-    TIAinstruction n(static_cast<Instruction>(NOP), pred, flags, inC, oC, 0, dq, drU);
-    return n;
+// Collects a T_WRITE word - true when the words make a whole instruction
+bool TIA::decode(int word, TIAinstruction &inst){
+    // A word that should start an instruction but isn't a header gets dropped, so we can't get stuck on garbage
+    if(this->loadWords.size() == 0 && TIAprogram::length(word) == 0){
+        fprintf(stderr, "TIA dropped program word %i that is not an instruction header\n", word);
+        return false;
+    }
+    this->loadWords.push_back(word);
+    if(this->loadWords.size() < TIAprogram::length(this->loadWords[0])){
+        return false;
+    }
+
+    bool ok = TIAprogram::decode(&this->loadWords[0], this->loadWords.size(), inst);
+    if(!ok){
+        fprintf(stderr, "TIA dropped a badly encoded instruction\n");
+    }
+    this->loadWords.clear();
+    return ok;
+}
+
+// Add every instruction of an encoded program to the instruction bank
+void TIA::addProgram(const TIAprogram &program){
+    const std::vector<int> &words = program.getWords();
+    TIAinstruction inst(NOP, std::vector<pair<int, bool> >(), std::vector<pair<int, bool> >(), std::vector<pair<int, int> >(),
+                        std::vector<pair<bool, int> >(), 0, std::vector<int>(), std::vector<pair<int, int> >());
+    int w = 0;
+    while(w < words.size()){
+        int len = TIAprogram::length(words[w]);
+	if(len == 0 || w + len > words.size()){
+	    break;
+	}
+	if(TIAprogram::decode(&words[w], len, inst)){
+	    this->addInstruction(inst);
+	}
+	w += len;
+    }
+}
+
+// Checks if there are program words waiting on T_WRITE
+bool TIA::isLoading(){
+    return this->helpChans->getNumChannels() > T_WRITE && this->helpChans->channels[T_WRITE]->numInFlight() > 0;
+}
+
+// Reads program words from T_WRITE - true if we must stop issuing to swap programs
+bool TIA::load(){
+    this->wordsLoaded = 0;
+    this->swapped = false;
+    if(this->helpChans->getNumChannels() <= T_WRITE){
+        return false;
+    }
+    liChannel * write = this->helpChans->channels[T_WRITE];
+    TIAinstruction newInst(NOP, std::vector<pair<int, bool> >(), std::vector<pair<int, bool> >(), std::vector<pair<int, int> >(),
+                           std::vector<pair<bool, int> >(), 0, std::vector<int>(), std::vector<pair<int, int> >());
+
+    for(int w=0; w < this->loadWidth && write->getCanPop() && write->numInFlight() > 0; w++){
+        int word = write->peek().data;
+
+	// Control words can only show up between instructions
+	int op = this->loadWords.size() == 0 ? TIAprogram::controlOp(word) : 0;
+	// A commit with no program loading would swap in an empty iMem, so it is dropped
+	if(op == TIA_COMMIT_PROGRAM && !this->loadingShadow){
+	    fprintf(stderr, "TIA dropped a program commit word with no program being loaded\n");
+	    write->get();
+	    this->wordsLoaded++;
+	    this->totalWordsLoaded++;
+	    continue;
+	}
+	if(op == TIA_COMMIT_PROGRAM){
+	    // The old program has to finish what it has in flight before we can swap
+	    if(this->inFlight.size() > 0){
+	        return true;
+	    }
+	    write->get();
+	    this->wordsLoaded++;
+	    this->totalWordsLoaded++;
+	    this->swapProgram();
+	    return false;
+	}
+	write->get();
+	this->wordsLoaded++;
+	this->totalWordsLoaded++;
+	if(op == TIA_BEGIN_PROGRAM){
+	    this->shadowMem.clear();
+	    this->loadingShadow = true;
+	}
+	else if(op == 0 && this->decode(word, newInst)){
+	    if(!this->loadingShadow){
+	        this->addInstruction(newInst);
+	    }
+	    else if(this->legal(newInst)){
+	        this->shadowMem.push_back(newInst);
+	    }
+	    else{
+	        fprintf(stderr, "TIA dropped a %s that uses a register or channel it doesn't have\n", CycleTimes::instructionName(static_cast<Instruction>(newInst.getCmd())));
+	    }
+	}
+    }
+    return false;
+}
+
+// Replaces iMem with the program loaded off to the side
+// Nothing is in flight, so the scoreboards are clear and the new program starts from a clean predicate state
+void TIA::swapProgram(){
+    this->iMem.swap(this->shadowMem);
+    this->shadowMem.clear();
+    this->loadingShadow = false;
+
+    this->triggers.clear();
+    this->readySince.clear();
+    for(int i=0; i < this->iMem.size(); i++){
+        this->triggers.push_back(this->lower(this->iMem[i]));
+	this->readySince.push_back(-1);
+    }
+    for(int r=0; r < this->predRegs.getNumRegs(); r++){
+        this->predRegs.setValue(r, false);
+    }
+    this->nextRR = 0;
+    this->swapped = true;
+    this->numSwaps++;
+}
+
+// Number of program words T_WRITE can deliver each cycle
+void TIA::setLoadWidth(int words){
+    this->loadWidth = words < 1 ? 1 : words;
+}
+
+// Program words read by the last schedule
+int TIA::getWordsLoaded(){
+    return this->wordsLoaded;
+}
+
+// Checks if the last schedule swapped in a new program
+bool TIA::getSwapped(){
+    return this->swapped;
+}
+
+// Program words read since the TIA was built
+int TIA::getTotalWordsLoaded(){
+    return this->totalWordsLoaded;
+}
+
+// Number of programs swapped in since the TIA was built
+int TIA::getNumSwaps(){
+    return this->numSwaps;
 }
 
 // Return a vector of instructions that can trigger
 std::vector<int> TIA::canTrigger(){
     std::vector<int> tList;
+
+    // If our registers and channels don't fit in the bitmasks, check each instruction the slow way
+    if(!this->masksFit){
+        for(int i=0; i < iMem.size(); i++){
+            if(this->canRun(iMem[i])){
+	        tList.push_back(i);
+	    }
+        }
+	return tList;
+    }
+
+    // Gather the live state of the fabric into bitmasks that match the lowered triggers
+    tiaMask predValues = 0, predBusy = 0, inCanPop = 0, inBusy = 0, tagValid = 0, tags = 0, outCanPush = 0, dataBusy = 0;
+    for(int r=0; r < this->predRegs.getNumRegs(); r++){
+        if(this->predRegs.getValue(r)){
+	    predValues |= 1ULL << r;
+	}
+	if(this->predScore[r]){
+	    predBusy |= 1ULL << r;
+	}
+    }
+    for(int c=0; c < this->inputChans->getNumChannels(); c++){
+        liChannel * chan = this->inputChans->channels[c];
+        if(chan->getCanPop()){
+	    inCanPop |= 1ULL << c;
+	}
+	if(this->inChanScore[c]){
+	    inBusy |= 1ULL << c;
+	}
+	if(chan->numInFlight() > 0){ // A tag can only match if there is a packet to look at
+	    tagValid |= 1ULL << c;
+	    if(chan->peek().tag[0]){
+	        tags |= 1ULL << c;
+	    }
+	}
+    }
+    for(int c=0; c < this->outputChans->getNumChannels(); c++){
+        if(this->outputChans->channels[c]->getCanPush()){
+	    outCanPush |= 1ULL << c;
+	}
+    }
+    for(int r=0; r < this->dataRegs.getNumRegs(); r++){
+        if(this->dataRegScore[r]){
+	    dataBusy |= 1ULL << r;
+	}
+    }
+
     // For each instruction in the iMem, check if it can be run, then add it to "tList" if it can
     for(int i=0; i < iMem.size(); i++){
-        if(this->canRun(iMem[i])){
-	    tList.push_back(i);
+        const TIAtrigger &t = this->triggers[i];
+	if(!t.lowered){
+	    if(this->canRun(iMem[i])){
+	        tList.push_back(i);
+	    }
+	    continue;
 	}
-    } 
+	if(t.never
+	   || ((predValues ^ t.predValue) & t.predMask)
+	   || (predBusy & t.predFree)
+	   || (t.allPredsFree && predBusy)
+	   || ((inCanPop & t.inReady) != t.inReady)
+	   || (inBusy & t.inFree)
+	   || ((tagValid & t.tagMask) != t.tagMask)
+	   || ((tags ^ t.tagValue) & t.tagMask)
+	   || ((outCanPush & t.outSpace) != t.outSpace)
+	   || (dataBusy & t.dataFree)){
+	    continue;
+	}
+	tList.push_back(i);
+    }
     return tList;
 }
 
-// Trigger instructions in tList, add all important info to scoreboards
-void TIA::trigger(std::vector<Dynamic_TIAinstruction> tList){
-    for(int i=0; i<tList.size(); i++){
-        // Add resources to scoreboard 
-	
-	// Add pred regs from the pred updates to the scoreboard
-        std::vector<pair<predUpdateType, pair<int, bool> > > pUp = iMem[tList[i].getIndex()].getPredUpdates();
-	for(int j=0; j< pUp.size(); j++){
-	    this->predScore[pUp[j].second.first] = true;
-	}
+// Trigger an instruction, add all important info to scoreboards
+void TIA::trigger(Dynamic_TIAinstruction &inst){
+    const TIAinstruction &instruction = iMem[inst.getIndex()];
 
-	// Add data regs from the data reg updates to the scoreboard
-	std::vector<pair<int, int> > drUp = iMem[tList[i].getIndex()].getDataRegUpdates();
-	for(int j=0; j< drUp.size(); j++){
-	    this->dataRegScore[drUp[j].first] = true;
-	}
+    // Add resources to scoreboard 
 
+    // Add pred regs from the pred updates to the scoreboard
+    const std::vector<pair<predUpdateType, pair<int, bool> > > &pUp = instruction.getPredUpdates();
+    for(int j=0; j< pUp.size(); j++){
+        this->predScore[pUp[j].second.first] = true;
+    }
 
-	// Add input channels that you are dequeuing to the scoreboard
-        std::vector<int> dQ = iMem[tList[i].getIndex()].getDequeue();
-	for(int j=0; j< dQ.size(); j++){
-	    this->inChanScore[dQ[j]] = true;
-	}
+    // Add data regs from the data reg updates to the scoreboard
+    const std::vector<pair<int, int> > &drUp = instruction.getDataRegUpdates();
+    for(int j=0; j< drUp.size(); j++){
+        this->dataRegScore[drUp[j].first] = true;
+    }
 
-	// Add output that goes to datt regs to the scoreboard
-	std::vector<pair<bool, int> > oList = iMem[tList[i].getIndex()].getOutput();
-	for(int j=0; j< oList.size(); j++){
-	    if(oList[j].first == false){ // Output is going to a data reg - add to scoreboard
-	        this->dataRegScore[oList[j].second] = true;
-	    }
+    // Add input channels that you are dequeuing to the scoreboard
+    const std::vector<int> &dQ = instruction.getDequeue();
+    for(int j=0; j< dQ.size(); j++){
+        this->inChanScore[dQ[j]] = true;
+    }
+
+    // Add output that goes to datt regs to the scoreboard
+    const std::vector<pair<bool, int> > &oList = instruction.getOutput();
+    for(int j=0; j< oList.size(); j++){
+        if(oList[j].first == false){ // Output is going to a data reg - add to scoreboard
+	    this->dataRegScore[oList[j].second] = true;
+        }
+	else{ // Output is going to a channel - claim it until we commit
+	    this->outClaimed[oList[j].second] = true;
 	}
     }
 }
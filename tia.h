@@ -6,18 +6,62 @@
 #include "liChannel.cpp"
 #include "baseClass.cpp"
 #include "multiChannel.cpp"
+#include "tiaProgram.cpp"
+
+// Bitmask type used to resolve triggers - one bit per predicate register, channel or data register
+typedef unsigned long long tiaMask;
+#define TIA_MASK_BITS 64
+
+// Trigger conditions of a TIAinstruction lowered into bitmasks when it is added to iMem
+// so that canTrigger only needs a few AND/compare operations per instruction
+struct TIAtrigger {
+    bool lowered;        // False if the instruction uses a resource past TIA_MASK_BITS - canRun is used instead
+    bool never;          // The instruction requires a predicate register to be both true and false
+    tiaMask predMask;    // Predicate registers whose value is checked
+    tiaMask predValue;   // Required values of those predicate registers
+    tiaMask predFree;    // Predicate registers that must not be on the scoreboard
+    bool allPredsFree;   // The instruction reads the whole predicate state, so no predicate can be on the scoreboard
+    tiaMask inReady;     // Input channels that must be able to pop
+    tiaMask inFree;      // Input channels that must not be on the scoreboard
+    tiaMask tagMask;     // Input channels whose tag is checked
+    tiaMask tagValue;    // Required tags on those channels
+    tiaMask outSpace;    // Output channels that must be able to push
+    tiaMask dataFree;    // Data registers that must not be on the scoreboard
+};
+
+// Ways that the scheduler can choose between ready instructions when it can't issue all of them
+enum IssuePolicy{
+    LOWEST_INDEX = 0,   // Lowest index in iMem first
+    ROUND_ROBIN = 1,    // Start looking after the last instruction that issued
+    OLDEST_READY = 2    // Instruction that has been ready for the most cycles first
+};
 
 class TIA: public Module {
     public:
-	TIA(multiChannel * hChans, multiChannel * iChans, multiChannel * oChans, int numPReg, int numDReg); // Constructor 
-	Dynamic_TIAinstruction schedule();                                  // Schedule and return an Dynamic Inst
+	TIA(multiChannel * hChans, multiChannel * iChans, multiChannel * oChans, int numPReg, int numDReg, int width = 1, IssuePolicy policy = LOWEST_INDEX, int depth = 1); // Constructor 
+	void schedule(std::vector<Dynamic_TIAinstruction> &bundle);         // Schedule up to issueWidth Dynamic Insts into bundle
+	void advance(std::vector<Dynamic_TIAinstruction> &bundle);          // Put an executed bundle in flight and commit every instruction that has finished
+	int getNumInFlight();                                               // Number of instructions in flight that have not committed
 	std::vector<int> canTrigger();                           // Return a vector of instructions that can trigger
-	void trigger(std::vector<Dynamic_TIAinstruction> tList);            // Trigger instructions in tList, add all important info to scoreboards
+	void orderReady(std::vector<int> &tList);                           // Sort ready instructions by the issue policy
+	bool conflicts(int index);                                          // Checks if an instruction can issue alongside the ones already issued
+	void trigger(Dynamic_TIAinstruction &inst);                         // Trigger an instruction, add all important info to scoreboards
 	Dynamic_TIAinstruction execute(Dynamic_TIAinstruction instruction); // Execute a dynamic instruction and pass it back
-	void commit(Dynamic_TIAinstruction instruction);                    // Commit dynamic instruction
-	void addInstruction(TIAinstruction newInst);                        // Add Instruction to instruction bank
-        bool canRun(TIAinstruction inst);                                   // Method to check if an instruction can trigger
-	TIAinstruction decode(int encodedInst);                             // Return a TIAinstruction from common ones 
+	void commit(Dynamic_TIAinstruction &instruction);                   // Commit dynamic instruction
+	void addInstruction(const TIAinstruction &newInst);                 // Add Instruction to instruction bank
+        bool canRun(const TIAinstruction &inst);                            // Method to check if an instruction can trigger
+	bool decode(int word, TIAinstruction &inst);                        // Collects a T_WRITE word - true when the words make a whole instruction
+	void addProgram(const TIAprogram &program);                         // Add every instruction of an encoded program to the instruction bank
+	bool isLoading();                                                   // Checks if there are program words waiting on T_WRITE
+	bool load();                                                        // Reads program words from T_WRITE - true if we must stop issuing to swap programs
+	bool legal(const TIAinstruction &inst);                             // Checks that an instruction only uses registers and channels we have
+	void swapProgram();                                                 // Replaces iMem with the program loaded off to the side
+	void setLoadWidth(int words);                                       // Number of program words T_WRITE can deliver each cycle
+	int getWordsLoaded();                                               // Program words read by the last schedule
+	bool getSwapped();                                                  // Checks if the last schedule swapped in a new program
+	int getTotalWordsLoaded();                                          // Program words read since the TIA was built
+	int getNumSwaps();                                                  // Number of programs swapped in since the TIA was built
+	TIAtrigger lower(const TIAinstruction &inst);                       // Lower the trigger conditions of an instruction into bitmasks
 
 	multiChannel *helpChans;                // Helper channels to program and update TIA state
 	multiChannel *inputChans;               // Input channels to the TIA module
@@ -25,9 +69,27 @@ class TIA: public Module {
 	PredRegs predRegs;                      // Predicate Registers
 	DataRegs dataRegs;                      // Data Registers
 	std::vector<TIAinstruction> iMem;       // Instruction bank for TIA
+	std::vector<int> loadWords;             // Words of the instruction being loaded through T_WRITE
+	std::vector<TIAinstruction> shadowMem;  // Program being loaded between TIA_BEGIN_PROGRAM and TIA_COMMIT_PROGRAM
+	bool loadingShadow;                     // Set while instructions go to shadowMem instead of iMem
+	int loadWidth;                          // Program words T_WRITE can deliver each cycle
+	int wordsLoaded;                        // Program words read by the last schedule
+	bool swapped;                           // Did the last schedule swap in a new program
+	int totalWordsLoaded;
+	int numSwaps;
 	std::vector<bool> predScore;            // Predicate Scoreboard
 	std::vector<bool> inChanScore;          // Input Channel Scoreboard
 	std::vector<bool> dataRegScore;         // Data Reg Scoreboard
+	std::vector<TIAtrigger> triggers;       // Lowered trigger conditions for each instruction in iMem
+	bool masksFit;                          // True if all of our registers and channels fit in a tiaMask
+	int issueWidth;                         // Most instructions that can issue in one cycle
+	IssuePolicy issuePolicy;                // How we choose between ready instructions
+	int nextRR;                             // Round robin pointer - the instruction after the last one issued
+	int scheduleCycle;                      // Number of times schedule has been called, used to age ready instructions
+	std::vector<int> readySince;            // Cycle each instruction became ready, or -1 if it is not ready
+	std::vector<bool> outClaimed;           // Output channels that an issued instruction will write when it commits
+	int pipelineDepth;                      // Number of cycles from schedule to commit - 1 commits in the cycle it issued
+	std::vector<pair<int, Dynamic_TIAinstruction> > inFlight; // Executed instructions waiting to commit, with the cycle they commit in
 };
 
 #endif
@@ -0,0 +1,385 @@
+///////////////////////////////////
+// TIA Program
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This file encodes, decodes, and assembles TIA programs.
+*/
+
+#ifndef TIAPROGRAM_CPP
+#define TIAPROGRAM_CPP
+
+#include"tiaProgram.h"
+
+// Names of the predicate update types in the text syntax - these line up with the enum
+static const char * predUpdateNames[4] = {"ANY", "ZERO", "LOB", "HOB"};
+
+// Builds a field word - false if the index doesn't fit in one
+static bool fieldWord(std::vector<int> &fields, int type, int index, bool value, int kind){
+    if(index < 0 || index > TIA_MAX_FIELD_INDEX){
+        return false;
+    }
+    fields.push_back((type << 28) | (kind << 17) | ((value ? 1 : 0) << 16) | index);
+    return true;
+}
+
+// Empty Constructor
+TIAprogram::TIAprogram(){
+    this->numInstructions = 0;
+    this->lineNum = 0;
+};
+
+// Appends the encoding of an instruction - false if it doesn't fit the encoding
+bool TIAprogram::encode(const TIAinstruction &inst, std::vector<int> &words){
+    std::vector<int> fields;
+    int i;
+
+    if(inst.getTagUpdate() < 0 || inst.getTagUpdate() > TIA_MAX_TAG_UPDATE){
+        return false;
+    }
+
+    const std::vector<pair<int, bool> > &pState = inst.getPredState();
+    for(i=0; i < pState.size(); i++){
+        if(!fieldWord(fields, TIA_FIELD_PRED_STATE, pState[i].first, pState[i].second, 0)){
+            return false;
+        }
+    }
+    const std::vector<pair<int, bool> > &iFlags = inst.getInputFlags();
+    for(i=0; i < iFlags.size(); i++){
+        if(!fieldWord(fields, TIA_FIELD_INPUT_FLAG, iFlags[i].first, iFlags[i].second, 0)){
+            return false;
+        }
+    }
+    const std::vector<pair<int, int> > &input = inst.getInput();
+    for(i=0; i < input.size(); i++){
+        if(input[i].first < 0 || input[i].first > 2){
+	    return false;
+	}
+        if(!fieldWord(fields, TIA_FIELD_INPUT, input[i].second, false, input[i].first)){
+            return false;
+        }
+    }
+    const std::vector<pair<bool, int> > &output = inst.getOutput();
+    for(i=0; i < output.size(); i++){
+        if(!fieldWord(fields, TIA_FIELD_OUTPUT, output[i].second, output[i].first, 0)){
+            return false;
+        }
+    }
+    const std::vector<int> &dQ = inst.getDequeue();
+    for(i=0; i < dQ.size(); i++){
+        if(!fieldWord(fields, TIA_FIELD_DEQUEUE, dQ[i], false, 0)){
+            return false;
+        }
+    }
+    const std::vector<pair<predUpdateType, pair<int, bool> > > &pUp = inst.getPredUpdates();
+    for(i=0; i < pUp.size(); i++){
+        if(!fieldWord(fields, TIA_FIELD_PRED_UPDATE, pUp[i].second.first, pUp[i].second.second, pUp[i].first)){
+            return false;
+        }
+    }
+    // Data reg updates carry a whole int, so the value gets its own word
+    const std::vector<pair<int, int> > &drUp = inst.getDataRegUpdates();
+    for(i=0; i < drUp.size(); i++){
+        if(!fieldWord(fields, TIA_FIELD_DATA_REG_UPDATE, drUp[i].first, false, 0)){
+            return false;
+        }
+	fields.push_back(drUp[i].second);
+    }
+
+    if(fields.size() > TIA_MAX_FIELD_WORDS){
+        return false;
+    }
+
+    words.push_back((TIA_HEADER_MAGIC << 24) | (inst.getTagUpdate() << 16) | (fields.size() << 8) | (inst.getCmd() & 0xFF));
+    words.insert(words.end(), fields.begin(), fields.end());
+    return true;
+};
+
+// Words in an instruction, counting its header - 0 if this isn't a header
+int TIAprogram::length(int header){
+    if(((header >> 24) & 0xFF) != TIA_HEADER_MAGIC){
+        return 0;
+    }
+    return 1 + ((header >> 8) & 0xFF);
+};
+
+// Decodes one whole instruction - false if the words are not a valid instruction
+bool TIAprogram::decode(const int * words, int numWords, TIAinstruction &inst){
+    if(numWords < 1 || length(words[0]) != numWords){
+        return false;
+    }
+    int cmd = words[0] & 0xFF;
+    if(cmd >= NUM_INSTRUCTIONS){
+        return false;
+    }
+
+    std::vector<pair<int, bool> > pState, iFlags;
+    std::vector<pair<int, int> > input, drUp;
+    std::vector<pair<bool, int> > output;
+    std::vector<int> dQ;
+    std::vector<pair<predUpdateType, pair<int, bool> > > pUp;
+
+    for(int w=1; w < numWords; w++){
+        int field = words[w];
+	int index = field & TIA_MAX_FIELD_INDEX;
+	bool value = ((field >> 16) & 1) == 1;
+	int kind = (field >> 17) & 3;
+	switch((field >> 28) & 0xF){
+	    case TIA_FIELD_PRED_STATE:
+	        pState.push_back(make_pair(index, value));
+		break;
+	    case TIA_FIELD_INPUT_FLAG:
+	        iFlags.push_back(make_pair(index, value));
+		break;
+	    case TIA_FIELD_INPUT:
+	        input.push_back(make_pair(kind, index));
+		break;
+	    case TIA_FIELD_OUTPUT:
+	        output.push_back(make_pair(value, index));
+		break;
+	    case TIA_FIELD_DEQUEUE:
+	        dQ.push_back(index);
+		break;
+	    case TIA_FIELD_PRED_UPDATE:
+	        pUp.push_back(make_pair(static_cast<predUpdateType>(kind), make_pair(index, value)));
+		break;
+	    case TIA_FIELD_DATA_REG_UPDATE:
+	        if(w + 1 >= numWords){
+		    return false;
+		}
+	        drUp.push_back(make_pair(index, words[++w]));
+		break;
+	    default:
+	        return false;
+	}
+    }
+
+    inst = TIAinstruction(static_cast<Instruction>(cmd), pState, iFlags, input, output, (words[0] >> 16) & 0xFF, dQ, drUp);
+    inst.setPredUpdates(pUp);
+    return true;
+};
+
+// Encodes an instruction and adds it - false if it doesn't fit the encoding
+bool TIAprogram::add(const TIAinstruction &inst){
+    if(!encode(inst, this->words)){
+        return false;
+    }
+    this->numInstructions++;
+    return true;
+};
+
+// Puts every word into a TIA's T_WRITE helper channel
+void TIAprogram::send(liChannel * helpChan){
+    struct packet p;
+    p.tag = 0;
+    for(int i=0; i < this->words.size(); i++){
+        p.data = this->words[i];
+	helpChan->put(p);
+    }
+};
+
+// Sends the program so that it replaces the TIA's whole iMem once it has all arrived
+void TIAprogram::sendSwap(liChannel * helpChan){
+    struct packet p;
+    p.tag = 0;
+    p.data = control(TIA_BEGIN_PROGRAM);
+    helpChan->put(p);
+    this->send(helpChan);
+    p.data = control(TIA_COMMIT_PROGRAM);
+    helpChan->put(p);
+};
+
+// Builds a control word
+int TIAprogram::control(int op){
+    return (TIA_CONTROL_MAGIC << 24) | (op & 0xFF);
+};
+
+// Operation of a control word - 0 if this isn't a control word
+int TIAprogram::controlOp(int word){
+    if(((word >> 24) & 0xFF) != TIA_CONTROL_MAGIC){
+        return 0;
+    }
+    return word & 0xFF;
+};
+
+// The encoded program
+const std::vector<int> &TIAprogram::getWords() const{
+    return this->words;
+};
+
+// Number of instructions in the program
+int TIAprogram::getNumInstructions() const{
+    return this->numInstructions;
+};
+
+// Empties the program
+void TIAprogram::clear(){
+    this->words.clear();
+    this->numInstructions = 0;
+};
+
+// Prints an error for the current line and returns false
+bool TIAprogram::error(const std::string &message){
+    fprintf(stderr, "TIA program line %i: %s\n", this->lineNum, message.c_str());
+    return false;
+};
+
+// Parses an index with a prefix, like p3, ch1, or r0
+bool TIAprogram::parseIndex(const std::string &text, const char * prefix, int &index){
+    std::string p(prefix);
+    if(text.compare(0, p.size(), p) != 0){
+        return false;
+    }
+    return parseInt(text.substr(p.size()), index) && index >= 0 && index <= TIA_MAX_FIELD_INDEX;
+};
+
+// Assembles a text program and adds it - false on an error
+bool TIAprogram::assemble(const char * fileName){
+    std::ifstream data(fileName);
+    if(!data.is_open()){
+        fprintf(stderr, "Could not open TIA program %s\n", fileName);
+        return false;
+    }
+
+    std::string line;
+    this->lineNum = 0;
+    while(readLine(data, line)){
+        this->lineNum++;
+	if(!this->assembleLine(line)){
+	    return false;
+	}
+    }
+    return true;
+};
+
+// Assembles one line of text - false on an error
+bool TIAprogram::assembleLine(const std::string &line){
+    std::stringstream tokens(line.substr(0, line.find('#')));
+    std::string cmdName, token;
+    if(!(tokens >> cmdName)){
+        return true;  // Blank line
+    }
+
+    int cmd = -1;
+    for(int i=0; i < NUM_INSTRUCTIONS; i++){
+        if(cmdName == CycleTimes::instructionName(static_cast<Instruction>(i))){
+	    cmd = i;
+	}
+    }
+    if(cmd == -1){
+        return this->error("unknown command " + cmdName);
+    }
+
+    std::vector<pair<int, bool> > pState, iFlags;
+    std::vector<pair<int, int> > input, drUp;
+    std::vector<pair<bool, int> > output;
+    std::vector<int> dQ;
+    std::vector<pair<predUpdateType, pair<int, bool> > > pUp;
+    int tag = 0;
+
+    while(tokens >> token){
+        size_t split = token.find('=');
+	if(split == std::string::npos){
+	    return this->error("expected key=value but found " + token);
+	}
+	std::string key = token.substr(0, split);
+	if(key == "tag"){
+	    if(!parseInt(token.substr(split + 1), tag) || tag < 0 || tag > TIA_MAX_TAG_UPDATE){
+	        return this->error("bad tag " + token);
+	    }
+	    continue;
+	}
+
+	// Every other field is a comma separated list of items, and items are split by colons
+	std::stringstream list(token.substr(split + 1));
+	std::string item;
+	while(std::getline(list, item, ',')){
+	    std::vector<std::string> parts;
+	    std::stringstream itemStream(item);
+	    std::string part;
+	    while(std::getline(itemStream, part, ':')){
+	        parts.push_back(part);
+	    }
+	    int index, value;
+
+	    if(key == "when" || key == "flags"){
+	        if(parts.size() != 2 || !this->parseIndex(parts[0], key == "when" ? "p" : "ch", index) ||
+		   !parseInt(parts[1], value) || value < 0 || value > 1){
+		    return this->error("bad " + key + " item " + item);
+		}
+		if(key == "when"){
+		    pState.push_back(make_pair(index, value == 1));
+		}
+		else{
+		    iFlags.push_back(make_pair(index, value == 1));
+		}
+	    }
+	    else if(key == "in"){
+	        if(item == "preds"){
+		    input.push_back(make_pair(2, 0));
+		}
+		else if(this->parseIndex(item, "ch", index)){
+		    input.push_back(make_pair(0, index));
+		}
+		else if(this->parseIndex(item, "r", index)){
+		    input.push_back(make_pair(1, index));
+		}
+		else{
+		    return this->error("bad input " + item);
+		}
+	    }
+	    else if(key == "out"){
+		if(this->parseIndex(item, "ch", index)){
+		    output.push_back(make_pair(true, index));
+		}
+		else if(this->parseIndex(item, "r", index)){
+		    output.push_back(make_pair(false, index));
+		}
+		else{
+		    return this->error("bad output " + item);
+		}
+	    }
+	    else if(key == "deq"){
+	        if(!this->parseIndex(item, "ch", index)){
+		    return this->error("bad dequeue " + item);
+		}
+		dQ.push_back(index);
+	    }
+	    else if(key == "pred"){
+	        int type = -1;
+		value = 0;
+		if(parts.size() >= 2){
+		    for(int t=0; t < 4; t++){
+		        if(parts[1] == predUpdateNames[t]){
+			    type = t;
+			}
+		    }
+		}
+	        if(parts.size() < 2 || parts.size() > 3 || !this->parseIndex(parts[0], "p", index) || type == -1 ||
+		   (parts.size() == 3 && (!parseInt(parts[2], value) || value < 0 || value > 1))){
+		    return this->error("bad predicate update " + item);
+		}
+		pUp.push_back(make_pair(static_cast<predUpdateType>(type), make_pair(index, value == 1)));
+	    }
+	    else if(key == "set"){
+	        if(parts.size() != 2 || !this->parseIndex(parts[0], "r", index) || !parseInt(parts[1], value)){
+		    return this->error("bad data register update " + item);
+		}
+		drUp.push_back(make_pair(index, value));
+	    }
+	    else{
+	        return this->error("unknown field " + key);
+	    }
+	}
+    }
+
+    TIAinstruction inst(static_cast<Instruction>(cmd), pState, iFlags, input, output, tag, dQ, drUp);
+    inst.setPredUpdates(pUp);
+    if(!this->add(inst)){
+        return this->error("instruction does not fit in the encoding");
+    }
+    return true;
+};
+
+#endif
@@ -0,0 +1,108 @@
+///////////////////////////////////
+// TIA Program Header File
+// Date   - 10/18/26
+//////////////////////////////////
+
+/*
+This is the header file for TIA programs.
+A TIAprogram holds instructions in a compact binary encoding
+that can be sent to a TIA one word at a time through its T_WRITE
+helper channel, and it can assemble that encoding from text.
+
+Each instruction starts with a header word:
+    bits 24-31  TIA_HEADER_MAGIC
+    bits 16-23  tag update
+    bits  8-15  number of field words that follow
+    bits  0-7   command (Instruction enum)
+Every field word has its type in bits 28-31, a register or channel
+index in bits 0-15, a true/false value in bit 16, and a kind in bits
+17-18 (input source or predicate update type).  Data register updates
+are followed by one more word that holds the value.
+
+Control words sit between instructions and have TIA_CONTROL_MAGIC in
+bits 24-31 and an operation in bits 0-7.  A program sent between
+TIA_BEGIN_PROGRAM and TIA_COMMIT_PROGRAM is loaded off to the side and
+replaces the TIA's whole iMem at once when the commit word arrives,
+so a TIA can switch kernels without ever running half of a program.
+
+The text syntax is one instruction per line, the command name
+followed by key=value fields, and # starts a comment:
+
+    GREATER_THAN when=p0:1,p1:0 flags=ch0:0 in=ch0,r0 pred=p1:ZERO,p2:ANY:1
+    PASS_THROUGH when=p2:1 in=ch0 out=ch1,r0 deq=ch0 tag=1 set=r1:5
+
+    when   predicate state to trigger on        p<n>:<0/1>
+    flags  tag an input channel must have       ch<n>:<0/1>
+    in     inputs                                ch<n>, r<n>, or preds
+    out    outputs                               ch<n> or r<n>
+    tag    tag on outgoing packets
+    deq    input channels to dequeue             ch<n>
+    pred   predicate updates                     p<n>:<ANY/ZERO/LOB/HOB>[:<0/1>]
+    set    data register updates                 r<n>:<value>
+*/
+
+#ifndef TIAPROGRAM_H
+#define TIAPROGRAM_H
+
+#include<vector>
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<stdlib.h>
+#include<stdio.h>
+using namespace std;
+
+#include"baseclass.h"
+#include"liChannel.cpp"
+#include"cycleTimes.cpp"
+
+// Top byte of every header word - lets decode reject words that aren't instructions
+#define TIA_HEADER_MAGIC 0x5A
+
+// Top byte of control words, and the operations they carry
+#define TIA_CONTROL_MAGIC 0x5B
+#define TIA_BEGIN_PROGRAM 1
+#define TIA_COMMIT_PROGRAM 2
+
+// Field types in bits 28-31 of a field word
+#define TIA_FIELD_PRED_STATE 1
+#define TIA_FIELD_INPUT_FLAG 2
+#define TIA_FIELD_INPUT 3
+#define TIA_FIELD_OUTPUT 4
+#define TIA_FIELD_DEQUEUE 5
+#define TIA_FIELD_PRED_UPDATE 6
+#define TIA_FIELD_DATA_REG_UPDATE 7
+
+// Largest register or channel index and tag update that fit in the encoding
+#define TIA_MAX_FIELD_INDEX 0xFFFF
+#define TIA_MAX_TAG_UPDATE 0xFF
+#define TIA_MAX_FIELD_WORDS 0xFF
+
+class TIAprogram{
+    public:
+	TIAprogram();                                          // Empty Constructor
+	bool assemble(const char * fileName);                  // Assembles a text program and adds it - false on an error
+	bool assembleLine(const std::string &line);            // Assembles one line of text - false on an error
+	bool add(const TIAinstruction &inst);                  // Encodes an instruction and adds it - false if it doesn't fit the encoding
+	void send(liChannel * helpChan);                       // Puts every word into a TIA's T_WRITE helper channel
+	void sendSwap(liChannel * helpChan);                   // Sends the program so that it replaces the TIA's whole iMem once it has all arrived
+	const std::vector<int> &getWords() const;              // The encoded program
+	int getNumInstructions() const;                        // Number of instructions in the program
+	void clear();                                          // Empties the program
+
+	static bool encode(const TIAinstruction &inst, std::vector<int> &words); // Appends the encoding of an instruction
+	static int length(int header);                         // Words in an instruction, counting its header - 0 if this isn't a header
+	static bool decode(const int * words, int numWords, TIAinstruction &inst); // Decodes one whole instruction
+	static int control(int op);                            // Builds a control word
+	static int controlOp(int word);                        // Operation of a control word - 0 if this isn't a control word
+
+    private:
+	std::vector<int> words;                                // Encoded instructions back to back
+	int numInstructions;
+	int lineNum;                                           // Line being assembled - used for errors
+	bool error(const std::string &message);                // Prints an error for the current line and returns false
+	bool parseIndex(const std::string &text, const char * prefix, int &index); // Parses p3, ch1, r0, ...
+};
+
+#endif
@@ -17,10 +17,20 @@
 #include<tuple>
 
 #include"liChannel.cpp"
+#include"spscChannel.cpp"
 #include"multiplier.cpp"
+#include"mac.cpp"
 #include"memStream.cpp"
 #include"fifo.cpp"
 #include"multiChannel.cpp"
 #include"tia.cpp"
+#include"cycleTimes.cpp"
+#include"threadPool.cpp"
+#include"mappedMemory.cpp"
+#include"bankedMemory.cpp"
+#include"cache.cpp"
+#include"simulator.cpp"
+#include"netlist.cpp"
+#include"sweepRunner.cpp"
 
 #endif